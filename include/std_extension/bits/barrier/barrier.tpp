@@ -0,0 +1,72 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ext {
+template <class CompletionFunction>
+barrier<CompletionFunction>::arrival_token::arrival_token(
+    detail::barrier_base::Phase phase) noexcept
+    : m_phase(phase) {}
+
+template <class CompletionFunction>
+constexpr std::ptrdiff_t barrier<CompletionFunction>::max() noexcept {
+    return std::numeric_limits<std::ptrdiff_t>::max();
+}
+
+template <class CompletionFunction>
+barrier<CompletionFunction>::barrier(std::ptrdiff_t expected, CompletionFunction f)
+    : m_completion(std::move(f))
+    , m_base(expected) {}
+
+template <class CompletionFunction>
+typename barrier<CompletionFunction>::arrival_token
+barrier<CompletionFunction>::arrive(std::ptrdiff_t update) {
+    detail::barrier_base::Phase old = m_base.phase();
+    for (; update > 0; --update) {
+        if (m_base.arrive(old)) {
+            m_completion();
+            m_base.advance(old);
+        }
+    }
+    return arrival_token(old);
+}
+
+template <class CompletionFunction>
+void barrier<CompletionFunction>::wait(arrival_token &&token) const {
+    m_base.wait(token.m_phase);
+}
+
+template <class CompletionFunction>
+template <class Clock, class Duration>
+bool barrier<CompletionFunction>::wait_until(
+    const arrival_token &token, const std::chrono::time_point<Clock, Duration> &abs_time) const {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        return m_base.waitUntil(token.m_phase,
+                                std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time));
+    } else {
+        auto rel_time =
+            std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time - Clock::now());
+        return m_base.waitUntil(token.m_phase, std::chrono::steady_clock::now() + rel_time);
+    }
+}
+
+template <class CompletionFunction>
+template <class Rep, class Period>
+bool barrier<CompletionFunction>::wait_for(
+    const arrival_token &token, const std::chrono::duration<Rep, Period> &rel_time) const {
+    return wait_until(token, std::chrono::steady_clock::now() + rel_time);
+}
+
+template <class CompletionFunction> void barrier<CompletionFunction>::arrive_and_wait() {
+    wait(arrive());
+}
+
+template <class CompletionFunction> void barrier<CompletionFunction>::arrive_and_drop() {
+    m_base.drop();
+    (void)arrive();
+}
+} // namespace ext
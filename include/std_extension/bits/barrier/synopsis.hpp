@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace ext {
+namespace detail {
+struct empty_completion {
+    void operator()() noexcept {}
+};
+
+class barrier_base {
+public:
+    using Phase = std::uint8_t;
+
+    explicit barrier_base(std::ptrdiff_t expected);
+
+    barrier_base(const barrier_base &)            = delete;
+    barrier_base &operator=(const barrier_base &) = delete;
+
+    ~barrier_base() = default;
+
+    Phase phase() const noexcept;
+    bool  arrive(Phase old) noexcept;
+    void  drop() noexcept;
+    void  advance(Phase old) noexcept;
+    void  wait(Phase old) const;
+    bool  waitUntil(Phase old, const std::chrono::steady_clock::time_point &abs_time) const;
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t ROUNDS     = 64;
+
+    struct alignas(CACHE_LINE) Node {
+        std::atomic<Phase> m_tickets[ROUNDS] = {};
+    };
+
+    std::ptrdiff_t          m_expected;
+    std::atomic_ptrdiff_t   m_adjustment;
+    std::atomic<Phase>      m_phase;
+    std::unique_ptr<Node[]> m_nodes;
+};
+} // namespace detail
+
+template <class CompletionFunction = detail::empty_completion> class barrier final {
+    static_assert(std::is_nothrow_invocable_v<CompletionFunction &>,
+                  "CompletionFunction must be nothrow invocable");
+
+public:
+    class arrival_token final {
+    public:
+        arrival_token(arrival_token &&)            = default;
+        arrival_token &operator=(arrival_token &&) = default;
+
+    private:
+        friend class barrier;
+
+        explicit arrival_token(detail::barrier_base::Phase phase) noexcept;
+
+        detail::barrier_base::Phase m_phase;
+    };
+
+    static constexpr std::ptrdiff_t max() noexcept;
+
+    explicit barrier(std::ptrdiff_t expected, CompletionFunction f = CompletionFunction());
+
+    barrier(const barrier &)            = delete;
+    barrier &operator=(const barrier &) = delete;
+
+    ~barrier() = default;
+
+    [[nodiscard]] arrival_token arrive(std::ptrdiff_t update = 1);
+
+    void wait(arrival_token &&token) const;
+
+    template <class Clock, class Duration>
+    bool wait_until(const arrival_token                            &token,
+                    const std::chrono::time_point<Clock, Duration> &abs_time) const;
+
+    template <class Rep, class Period>
+    bool wait_for(const arrival_token                      &token,
+                  const std::chrono::duration<Rep, Period> &rel_time) const;
+
+    void arrive_and_wait();
+    void arrive_and_drop();
+
+private:
+    CompletionFunction   m_completion;
+    detail::barrier_base m_base;
+};
+} // namespace ext
@@ -20,6 +20,23 @@ blocking_deque<E, Allocator, CountingSemaphore>::blocking_deque(const Allocator
     , m_semPop(0)
     , m_deque(AllocatorSharedPtr(alloc)) {}
 
+template <class E, class Allocator, class CountingSemaphore>
+blocking_deque<E, Allocator, CountingSemaphore>::blocking_deque(std::size_t    max_capacity,
+                                                                barging_policy policy)
+    requires std::constructible_from<CountingSemaphore, std::size_t, barging_policy>
+    : blocking_deque(Allocator(), max_capacity, policy) {}
+
+template <class E, class Allocator, class CountingSemaphore>
+blocking_deque<E, Allocator, CountingSemaphore>::blocking_deque(const Allocator &alloc,
+                                                                std::size_t      max_capacity,
+                                                                barging_policy   policy)
+    requires std::constructible_from<CountingSemaphore, std::size_t, barging_policy>
+    : m_alloc(alloc)
+    , m_maxCapacity(max_capacity)
+    , m_semPush(max_capacity, policy)
+    , m_semPop(0, policy)
+    , m_deque(AllocatorSharedPtr(alloc)) {}
+
 template <class E, class Allocator, class CountingSemaphore>
 std::size_t blocking_deque<E, Allocator, CountingSemaphore>::size() const noexcept {
     std::lock_guard guard(m_mutex);
@@ -19,6 +19,13 @@ public:
     blocking_deque(const Allocator &alloc,
                    std::size_t      max_capacity = std::numeric_limits<int>::max());
 
+    // lets a fair deque trade some ordering back for throughput
+    blocking_deque(std::size_t max_capacity, barging_policy policy)
+        requires std::constructible_from<CountingSemaphore, std::size_t, barging_policy>;
+
+    blocking_deque(const Allocator &alloc, std::size_t max_capacity, barging_policy policy)
+        requires std::constructible_from<CountingSemaphore, std::size_t, barging_policy>;
+
     blocking_deque(const blocking_deque &)            = delete;
     blocking_deque &operator=(const blocking_deque &) = delete;
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <utility>
+
+namespace ext {
+template <class E, class Allocator>
+void concurrent_queue<E, Allocator>::NodeDeleter::operator()(Node *node) const noexcept {
+    AllocatorNode alloc = node->m_alloc;
+    AllocatorTraitsNode::destroy(alloc, node);
+    AllocatorTraitsNode::deallocate(alloc, node, 1);
+}
+
+template <class E, class Allocator>
+concurrent_queue<E, Allocator>::Node::Node(const AllocatorNode &alloc,
+                                           std::shared_ptr<E>   element) noexcept
+    : m_alloc(alloc)
+    , m_element(std::move(element)) {}
+
+template <class E, class Allocator>
+concurrent_queue<E, Allocator>::concurrent_queue()
+    : concurrent_queue(Allocator()) {}
+
+template <class E, class Allocator>
+concurrent_queue<E, Allocator>::concurrent_queue(const Allocator &alloc)
+    : m_alloc(alloc)
+    , m_nodeAlloc(alloc)
+    , m_head(newNode(nullptr))
+    , m_tail(m_head.load(std::memory_order_relaxed)) {}
+
+template <class E, class Allocator> concurrent_queue<E, Allocator>::~concurrent_queue() {
+    Node *node = m_head.load(std::memory_order_relaxed);
+    while (nullptr != node) {
+        NodeDeleter()(std::exchange(node, node->m_next.load(std::memory_order_relaxed)));
+    }
+}
+
+template <class E, class Allocator>
+[[nodiscard]] concurrent_queue<E, Allocator>::allocator_type
+concurrent_queue<E, Allocator>::get_allocator() const noexcept {
+    return m_alloc;
+}
+
+template <class E, class Allocator>
+template <class U, class... Args>
+    requires std::constructible_from<U, Args...>
+[[nodiscard]] std::shared_ptr<E>
+concurrent_queue<E, Allocator>::newElement(Args &&...args) const {
+    return ::ext::make_shared<U>(m_alloc, std::forward<Args>(args)...);
+}
+
+template <class E, class Allocator>
+[[nodiscard]] concurrent_queue<E, Allocator>::Node *
+concurrent_queue<E, Allocator>::newNode(std::shared_ptr<E> element) {
+    Node *node = AllocatorTraitsNode::allocate(m_nodeAlloc, 1);
+    AllocatorTraitsNode::construct(m_nodeAlloc, node, m_nodeAlloc, std::move(element));
+    return node;
+}
+
+template <class E, class Allocator>
+void concurrent_queue<E, Allocator>::push(std::shared_ptr<E> element) {
+    Node        *node  = newNode(std::move(element));
+    epoch::guard guard = m_epoch.pin();
+    // counted before linking so a racing pop never drives the count below zero
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    while (true) {
+        Node *tail = m_tail.load(std::memory_order_acquire);
+        Node *next = tail->m_next.load(std::memory_order_acquire);
+        if (nullptr != next) {
+            // the tail lags behind, help the pusher that linked next before retrying
+            m_tail.compare_exchange_weak(tail, next, std::memory_order_release,
+                                         std::memory_order_relaxed);
+            continue;
+        }
+
+        if (tail->m_next.compare_exchange_weak(next, node, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+            m_tail.compare_exchange_strong(tail, node, std::memory_order_release,
+                                           std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+template <class E, class Allocator>
+template <class U>
+    requires std::constructible_from<E, U>
+std::shared_ptr<E> concurrent_queue<E, Allocator>::push(U &&element) {
+    std::shared_ptr<E> res = newElement<E>(std::forward<U>(element));
+    push(res);
+    return res;
+}
+
+template <class E, class Allocator>
+template <class U, class... Args>
+    requires std::constructible_from<U, Args...>
+std::shared_ptr<E> concurrent_queue<E, Allocator>::emplace(Args &&...args) {
+    std::shared_ptr<E> res = newElement<U>(std::forward<Args>(args)...);
+    push(res);
+    return res;
+}
+
+template <class E, class Allocator>
+[[nodiscard]] std::shared_ptr<E> concurrent_queue<E, Allocator>::try_pop() {
+    epoch::guard guard = m_epoch.pin();
+    while (true) {
+        Node *head = m_head.load(std::memory_order_acquire);
+        Node *next = head->m_next.load(std::memory_order_acquire);
+        if (nullptr == next) {
+            return nullptr;
+        }
+
+        // never let head pass the tail, or the tail would point at a retired node
+        Node *tail = m_tail.load(std::memory_order_acquire);
+        if (head == tail) {
+            m_tail.compare_exchange_weak(tail, next, std::memory_order_release,
+                                         std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+            // next is the new sentinel, only the thread that installed it may take its element
+            std::shared_ptr<E> res = std::move(next->m_element);
+            m_count.fetch_sub(1, std::memory_order_relaxed);
+            m_epoch.retire<Node, NodeDeleter>(head);
+            return res;
+        }
+    }
+}
+
+template <class E, class Allocator>
+[[nodiscard]] concurrent_queue<E, Allocator>::size_type
+concurrent_queue<E, Allocator>::size() const noexcept {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+template <class E, class Allocator>
+[[nodiscard]] bool concurrent_queue<E, Allocator>::empty() const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *head  = m_head.load(std::memory_order_acquire);
+    return nullptr == head->m_next.load(std::memory_order_acquire);
+}
+} // namespace ext
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "std_extension/epoch.hpp"
+#include "std_extension/memory.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+namespace ext {
+// Popped nodes are reclaimed through an epoch domain owned by the queue, so none of them outlives
+// the queue or the memory behind its allocator.
+template <class E, class Allocator = ext::allocator<E>> class concurrent_queue final {
+public:
+    using allocator_type = Allocator;
+    using size_type      = std::size_t;
+
+    concurrent_queue();
+    explicit concurrent_queue(const Allocator &alloc);
+
+    concurrent_queue(const concurrent_queue &)            = delete;
+    concurrent_queue &operator=(const concurrent_queue &) = delete;
+
+    ~concurrent_queue();
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+    void push(std::shared_ptr<E> element);
+
+    template <class U>
+        requires std::constructible_from<E, U>
+    std::shared_ptr<E> push(U &&element);
+
+    template <class U = E, class... Args>
+        requires std::constructible_from<U, Args...>
+    std::shared_ptr<E> emplace(Args &&...args);
+
+    [[nodiscard]] std::shared_ptr<E> try_pop();
+
+    // approximate while producers and consumers are running
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] bool      empty() const;
+
+private:
+    struct Node;
+
+    using AllocatorNode       = typename std::allocator_traits<Allocator>::rebind_alloc<Node>;
+    using AllocatorTraitsNode = typename std::allocator_traits<Allocator>::rebind_traits<Node>;
+
+    // stateless, so epoch::retire can default-construct it; each node carries its own allocator
+    struct NodeDeleter {
+        void operator()(Node *node) const noexcept;
+    };
+
+    struct Node {
+        Node(const AllocatorNode &alloc, std::shared_ptr<E> element) noexcept;
+
+        [[no_unique_address]] AllocatorNode m_alloc;
+        std::shared_ptr<E>                  m_element;
+        std::atomic<Node *>                 m_next = nullptr;
+    };
+
+    template <class U, class... Args>
+        requires std::constructible_from<U, Args...>
+    [[nodiscard]] std::shared_ptr<E> newElement(Args &&...args) const;
+
+    [[nodiscard]] Node *newNode(std::shared_ptr<E> element);
+
+    [[no_unique_address]] Allocator     m_alloc;
+    [[no_unique_address]] AllocatorNode m_nodeAlloc;
+    alignas(64) std::atomic<Node *>     m_head;
+    alignas(64) std::atomic<Node *>     m_tail;
+    alignas(64) std::atomic<size_type>  m_count = 0;
+    mutable epoch                       m_epoch; // last, so retired nodes are freed first
+};
+} // namespace ext
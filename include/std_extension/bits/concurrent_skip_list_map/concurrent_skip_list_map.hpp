@@ -0,0 +1,3 @@
+#pragma once
+
+#include "concurrent_skip_list_map.tpp"
@@ -0,0 +1,386 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <thread>
+#include <tuple>
+
+namespace ext {
+template <class K, class V, class Compare, class Allocator>
+template <class... Args>
+concurrent_skip_list_map<K, V, Compare, Allocator>::Node::Node(concurrent_skip_list_map *owner,
+                                                               std::size_t level, const K &key,
+                                                               Args &&...args)
+    : m_owner(owner)
+    , m_level(level)
+    , m_value(std::piecewise_construct, std::forward_as_tuple(key),
+              std::forward_as_tuple(std::forward<Args>(args)...)) {
+    std::uninitialized_value_construct_n(links(), level);
+}
+
+template <class K, class V, class Compare, class Allocator>
+typename concurrent_skip_list_map<K, V, Compare, Allocator>::Link *
+concurrent_skip_list_map<K, V, Compare, Allocator>::Node::links() noexcept {
+    // the tower lives right behind the node, in the same allocation
+    return reinterpret_cast<Link *>(this + 1);
+}
+
+template <class K, class V, class Compare, class Allocator>
+concurrent_skip_list_map<K, V, Compare, Allocator>::concurrent_skip_list_map(
+    const Compare &compare, const Allocator &alloc)
+    : m_compare(compare)
+    , m_alloc(alloc)
+    , m_nodeAlloc(alloc) {}
+
+template <class K, class V, class Compare, class Allocator>
+concurrent_skip_list_map<K, V, Compare, Allocator>::concurrent_skip_list_map(
+    const Allocator &alloc)
+    : concurrent_skip_list_map(Compare(), alloc) {}
+
+template <class K, class V, class Compare, class Allocator>
+concurrent_skip_list_map<K, V, Compare, Allocator>::~concurrent_skip_list_map() {
+    Node *node = pointer(m_head[0].load(std::memory_order_acquire));
+    while (nullptr != node) {
+        deleteNode(std::exchange(node, pointer(node->links()[0].load(std::memory_order_relaxed))));
+    }
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] concurrent_skip_list_map<K, V, Compare, Allocator>::allocator_type
+concurrent_skip_list_map<K, V, Compare, Allocator>::get_allocator() const noexcept {
+    return m_alloc;
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] std::optional<V>
+concurrent_skip_list_map<K, V, Compare, Allocator>::find(const K &key) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = seek(key, true);
+    if (nullptr == node || less(key, node->m_value.first)) {
+        return std::nullopt;
+    }
+    return node->m_value.second;
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] bool
+concurrent_skip_list_map<K, V, Compare, Allocator>::contains(const K &key) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = seek(key, true);
+    return nullptr != node && !less(key, node->m_value.first);
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] std::optional<typename concurrent_skip_list_map<K, V, Compare, Allocator>::value_type>
+concurrent_skip_list_map<K, V, Compare, Allocator>::front() const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = firstLive(pointer(m_head[0].load(std::memory_order_acquire)));
+    if (nullptr == node) {
+        return std::nullopt;
+    }
+    return node->m_value;
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] std::optional<typename concurrent_skip_list_map<K, V, Compare, Allocator>::value_type>
+concurrent_skip_list_map<K, V, Compare, Allocator>::lower_bound(const K &key) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = seek(key, true);
+    if (nullptr == node) {
+        return std::nullopt;
+    }
+    return node->m_value;
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] std::optional<typename concurrent_skip_list_map<K, V, Compare, Allocator>::value_type>
+concurrent_skip_list_map<K, V, Compare, Allocator>::upper_bound(const K &key) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = seek(key, false);
+    if (nullptr == node) {
+        return std::nullopt;
+    }
+    return node->m_value;
+}
+
+template <class K, class V, class Compare, class Allocator>
+template <class F>
+    requires std::invocable<F &, const std::pair<const K, V> &>
+void concurrent_skip_list_map<K, V, Compare, Allocator>::for_each(F &&f) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = firstLive(pointer(m_head[0].load(std::memory_order_acquire)));
+    while (nullptr != node) {
+        std::invoke(f, std::as_const(node->m_value));
+        node = firstLive(pointer(node->links()[0].load(std::memory_order_acquire)));
+    }
+}
+
+template <class K, class V, class Compare, class Allocator>
+template <class F>
+    requires std::invocable<F &, const std::pair<const K, V> &>
+void concurrent_skip_list_map<K, V, Compare, Allocator>::for_each_range(const K &first,
+                                                                        const K &last,
+                                                                        F      &&f) const {
+    epoch::guard guard = m_epoch.pin();
+    Node        *node  = seek(first, true);
+    while (nullptr != node && less(node->m_value.first, last)) {
+        std::invoke(f, std::as_const(node->m_value));
+        node = firstLive(pointer(node->links()[0].load(std::memory_order_acquire)));
+    }
+}
+
+template <class K, class V, class Compare, class Allocator>
+template <class... Args>
+    requires std::constructible_from<V, Args...>
+bool concurrent_skip_list_map<K, V, Compare, Allocator>::try_emplace(const K &key,
+                                                                     Args &&...args) {
+    epoch::guard                  guard = m_epoch.pin();
+    Path                          preds;
+    std::array<Node *, MAX_LEVEL> succs;
+    Node                         *node   = nullptr;
+    std::size_t                   height = randomLevel();
+
+    // raised before the tower can be linked anywhere, so every search that can reach the node
+    // also descends from at least its height
+    std::size_t top = m_levels.load(std::memory_order_relaxed);
+    while (top < height &&
+           !m_levels.compare_exchange_weak(top, height, std::memory_order_relaxed)) {}
+
+    while (true) {
+        if (search(key, preds, succs)) {
+            if (nullptr != node) {
+                deleteNode(node);
+            }
+            return false;
+        }
+        if (nullptr == node) {
+            node = newNode(height, key, std::forward<Args>(args)...);
+        }
+        for (std::size_t level = 0; level < node->m_level; ++level) {
+            node->links()[level].store(pack(succs[level]), std::memory_order_relaxed);
+        }
+        // linking the bottom level is the linearization point
+        std::uintptr_t expected = pack(succs[0]);
+        if (preds[0][0].compare_exchange_strong(expected, pack(node), std::memory_order_acq_rel,
+                                                std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    // the upper levels are only shortcuts; give up on them as soon as the node is being erased
+    for (std::size_t level = 1; level < node->m_level; ++level) {
+        while (!marked(node->links()[0].load(std::memory_order_acquire))) {
+            std::uintptr_t link = node->links()[level].load(std::memory_order_acquire);
+            if (marked(link)
+                || (pointer(link) != succs[level]
+                    && !node->links()[level].compare_exchange_strong(
+                        link, pack(succs[level]), std::memory_order_acq_rel,
+                        std::memory_order_relaxed))) {
+                break;
+            }
+            std::uintptr_t expected = pack(succs[level]);
+            if (preds[level][level].compare_exchange_strong(expected, pack(node),
+                                                            std::memory_order_acq_rel,
+                                                            std::memory_order_relaxed)) {
+                break;
+            }
+            if (!search(key, preds, succs) || node != succs[0]) {
+                break;
+            }
+        }
+    }
+
+    // an eraser may have unlinked the node before a level was linked above; unlink it again
+    if (marked(node->links()[0].load(std::memory_order_acquire))) {
+        search(key, preds, succs);
+    }
+    release(node);
+    return true;
+}
+
+template <class K, class V, class Compare, class Allocator>
+bool concurrent_skip_list_map<K, V, Compare, Allocator>::erase(const K &key) {
+    epoch::guard                  guard = m_epoch.pin();
+    Path                          preds;
+    std::array<Node *, MAX_LEVEL> succs;
+    if (!search(key, preds, succs)) {
+        return false;
+    }
+
+    Node *node = succs[0];
+    for (std::size_t level = node->m_level - 1; level > 0; --level) {
+        std::uintptr_t link = node->links()[level].load(std::memory_order_relaxed);
+        while (!marked(link)
+               && !node->links()[level].compare_exchange_weak(
+                   link, link | MARK, std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+    }
+
+    // whoever marks the bottom level owns the erase
+    std::uintptr_t link = node->links()[0].load(std::memory_order_acquire);
+    do {
+        if (marked(link)) {
+            return false;
+        }
+    } while (!node->links()[0].compare_exchange_weak(link, link | MARK, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire));
+
+    search(key, preds, succs);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    release(node);
+    return true;
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] concurrent_skip_list_map<K, V, Compare, Allocator>::size_type
+concurrent_skip_list_map<K, V, Compare, Allocator>::size() const noexcept {
+    return std::max<std::ptrdiff_t>(0, m_size.load(std::memory_order_relaxed));
+}
+
+template <class K, class V, class Compare, class Allocator>
+[[nodiscard]] bool concurrent_skip_list_map<K, V, Compare, Allocator>::empty() const {
+    epoch::guard guard = m_epoch.pin();
+    return nullptr == firstLive(pointer(m_head[0].load(std::memory_order_acquire)));
+}
+
+template <class K, class V, class Compare, class Allocator>
+typename concurrent_skip_list_map<K, V, Compare, Allocator>::Node *
+concurrent_skip_list_map<K, V, Compare, Allocator>::pointer(std::uintptr_t link) noexcept {
+    return reinterpret_cast<Node *>(link & ~MARK);
+}
+
+template <class K, class V, class Compare, class Allocator>
+bool concurrent_skip_list_map<K, V, Compare, Allocator>::marked(std::uintptr_t link) noexcept {
+    return 0 != (link & MARK);
+}
+
+template <class K, class V, class Compare, class Allocator>
+std::uintptr_t concurrent_skip_list_map<K, V, Compare, Allocator>::pack(Node *node) noexcept {
+    return reinterpret_cast<std::uintptr_t>(node);
+}
+
+template <class K, class V, class Compare, class Allocator>
+std::size_t concurrent_skip_list_map<K, V, Compare, Allocator>::units(std::size_t level) noexcept {
+    return 1 + (level * sizeof(Link) + sizeof(Node) - 1) / sizeof(Node);
+}
+
+template <class K, class V, class Compare, class Allocator>
+std::size_t concurrent_skip_list_map<K, V, Compare, Allocator>::randomLevel() noexcept {
+    thread_local std::uint64_t state =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) * 0x9e3779b97f4a7c15 | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    // geometric with p = 1/2, capped at MAX_LEVEL
+    return 1 + std::countr_zero(state | std::uint64_t(1) << (MAX_LEVEL - 1));
+}
+
+template <class K, class V, class Compare, class Allocator>
+typename concurrent_skip_list_map<K, V, Compare, Allocator>::Node *
+concurrent_skip_list_map<K, V, Compare, Allocator>::firstLive(Node *node) noexcept {
+    while (nullptr != node) {
+        std::uintptr_t link = node->links()[0].load(std::memory_order_acquire);
+        if (!marked(link)) {
+            break;
+        }
+        node = pointer(link);
+    }
+    return node;
+}
+
+template <class K, class V, class Compare, class Allocator>
+void concurrent_skip_list_map<K, V, Compare, Allocator>::reclaim(void *node) noexcept {
+    static_cast<Node *>(node)->m_owner->deleteNode(static_cast<Node *>(node));
+}
+
+template <class K, class V, class Compare, class Allocator>
+bool concurrent_skip_list_map<K, V, Compare, Allocator>::less(const K &lhs, const K &rhs) const {
+    return std::invoke(m_compare, lhs, rhs);
+}
+
+template <class K, class V, class Compare, class Allocator>
+template <class... Args>
+typename concurrent_skip_list_map<K, V, Compare, Allocator>::Node *
+concurrent_skip_list_map<K, V, Compare, Allocator>::newNode(std::size_t level, const K &key,
+                                                            Args &&...args) {
+    Node *node = AllocatorTraitsNode::allocate(m_nodeAlloc, units(level));
+    try {
+        AllocatorTraitsNode::construct(m_nodeAlloc, node, this, level, key,
+                                       std::forward<Args>(args)...);
+    } catch (...) {
+        AllocatorTraitsNode::deallocate(m_nodeAlloc, node, units(level));
+        throw;
+    }
+    return node;
+}
+
+template <class K, class V, class Compare, class Allocator>
+void concurrent_skip_list_map<K, V, Compare, Allocator>::deleteNode(Node *node) noexcept {
+    std::size_t level = node->m_level;
+    AllocatorTraitsNode::destroy(m_nodeAlloc, node);
+    AllocatorTraitsNode::deallocate(m_nodeAlloc, node, units(level));
+}
+
+template <class K, class V, class Compare, class Allocator>
+void concurrent_skip_list_map<K, V, Compare, Allocator>::release(Node *node) noexcept {
+    if (1 == node->m_refs.fetch_sub(1, std::memory_order_acq_rel)) {
+        m_epoch.retire(node, &reclaim);
+    }
+}
+
+template <class K, class V, class Compare, class Allocator>
+bool concurrent_skip_list_map<K, V, Compare, Allocator>::search(
+    const K &key, Path &preds, std::array<Node *, MAX_LEVEL> &succs) {
+    bool retry = true;
+    while (retry) {
+        retry             = false;
+        Link       *pred  = m_head.data();
+        std::size_t level = m_levels.load(std::memory_order_relaxed);
+        while (!retry && level-- > 0) {
+            Node *curr = pointer(pred[level].load(std::memory_order_acquire));
+            while (nullptr != curr) {
+                std::uintptr_t link = curr->links()[level].load(std::memory_order_acquire);
+                if (marked(link)) {
+                    // snip the erased node out of this level, or start over if pred changed
+                    std::uintptr_t expected = pack(curr);
+                    if (!pred[level].compare_exchange_strong(expected, link & ~MARK,
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_relaxed)) {
+                        retry = true;
+                        break;
+                    }
+                    curr = pointer(link);
+                    continue;
+                }
+                if (!less(curr->m_value.first, key)) {
+                    break;
+                }
+                pred = curr->links();
+                curr = pointer(link);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+    }
+    return nullptr != succs[0] && !less(key, succs[0]->m_value.first);
+}
+
+template <class K, class V, class Compare, class Allocator>
+typename concurrent_skip_list_map<K, V, Compare, Allocator>::Node *
+concurrent_skip_list_map<K, V, Compare, Allocator>::seek(const K &key, bool inclusive) const {
+    const Link *pred = m_head.data();
+    Node       *curr = nullptr;
+    for (std::size_t level = m_levels.load(std::memory_order_relaxed); level-- > 0;) {
+        curr = pointer(pred[level].load(std::memory_order_acquire));
+        while (nullptr != curr
+               && (inclusive ? less(curr->m_value.first, key) : !less(key, curr->m_value.first))) {
+            pred = curr->links();
+            curr = pointer(pred[level].load(std::memory_order_acquire));
+        }
+    }
+    return firstLive(curr);
+}
+} // namespace ext
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "std_extension/epoch.hpp"
+#include "std_extension/memory.hpp"
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ext {
+// Scans are weakly consistent: they see every entry present for their whole duration and may or
+// may not see entries inserted or erased while they run.
+template <class K, class V, class Compare = std::less<K>,
+          class Allocator = ext::allocator<std::pair<const K, V>>>
+class concurrent_skip_list_map final {
+public:
+    using key_type       = K;
+    using mapped_type    = V;
+    using value_type     = std::pair<const K, V>;
+    using size_type      = std::size_t;
+    using key_compare    = Compare;
+    using allocator_type = Allocator;
+
+    explicit concurrent_skip_list_map(const Compare   &compare = Compare(),
+                                      const Allocator &alloc   = Allocator());
+
+    explicit concurrent_skip_list_map(const Allocator &alloc);
+
+    concurrent_skip_list_map(const concurrent_skip_list_map &)            = delete;
+    concurrent_skip_list_map &operator=(const concurrent_skip_list_map &) = delete;
+
+    ~concurrent_skip_list_map();
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+    [[nodiscard]] std::optional<V> find(const K &key) const;
+    [[nodiscard]] bool             contains(const K &key) const;
+
+    [[nodiscard]] std::optional<value_type> front() const;
+    [[nodiscard]] std::optional<value_type> lower_bound(const K &key) const;
+    [[nodiscard]] std::optional<value_type> upper_bound(const K &key) const;
+
+    template <class F>
+        requires std::invocable<F &, const std::pair<const K, V> &>
+    void for_each(F &&f) const;
+
+    // visits [first, last) in key order
+    template <class F>
+        requires std::invocable<F &, const std::pair<const K, V> &>
+    void for_each_range(const K &first, const K &last, F &&f) const;
+
+    template <class... Args>
+        requires std::constructible_from<V, Args...>
+    bool try_emplace(const K &key, Args &&...args);
+
+    bool erase(const K &key);
+
+    // approximate while writers are running
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] bool      empty() const;
+
+private:
+    static constexpr std::size_t   MAX_LEVEL = 32;
+    static constexpr std::uintptr_t MARK      = 1;
+
+    using Link = std::atomic_uintptr_t;
+
+    struct Node {
+        template <class... Args>
+        Node(concurrent_skip_list_map *owner, std::size_t level, const K &key, Args &&...args);
+
+        Link *links() noexcept;
+
+        concurrent_skip_list_map *m_owner;
+        const std::size_t         m_level;
+        std::atomic_uint8_t       m_refs = 2; // one for the inserter, one for the eraser
+        value_type                m_value;
+    };
+
+    using AllocatorNode       = typename std::allocator_traits<Allocator>::rebind_alloc<Node>;
+    using AllocatorTraitsNode = typename std::allocator_traits<Allocator>::rebind_traits<Node>;
+    using Path                = std::array<Link *, MAX_LEVEL>;
+
+    static Node          *pointer(std::uintptr_t link) noexcept;
+    static bool           marked(std::uintptr_t link) noexcept;
+    static std::uintptr_t pack(Node *node) noexcept;
+    static std::size_t    units(std::size_t level) noexcept;
+    static std::size_t    randomLevel() noexcept;
+    static Node          *firstLive(Node *node) noexcept;
+    static void           reclaim(void *node) noexcept;
+
+    bool less(const K &lhs, const K &rhs) const;
+
+    template <class... Args> Node *newNode(std::size_t level, const K &key, Args &&...args);
+    void                           deleteNode(Node *node) noexcept;
+    void                           release(Node *node) noexcept;
+
+    bool  search(const K &key, Path &preds, std::array<Node *, MAX_LEVEL> &succs);
+    Node *seek(const K &key, bool inclusive) const;
+
+    [[no_unique_address]] Compare       m_compare;
+    [[no_unique_address]] Allocator     m_alloc;
+    [[no_unique_address]] AllocatorNode m_nodeAlloc;
+    std::array<Link, MAX_LEVEL>         m_head   = {};
+    std::atomic_size_t                  m_levels = 1; // height of the tallest tower ever inserted
+    std::atomic<std::ptrdiff_t>         m_size   = 0;
+    mutable epoch                       m_epoch; // last, so retired nodes are freed first
+};
+} // namespace ext
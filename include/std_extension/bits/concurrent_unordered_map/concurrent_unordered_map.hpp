@@ -0,0 +1,3 @@
+#pragma once
+
+#include "concurrent_unordered_map.tpp"
@@ -0,0 +1,455 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace ext {
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class... Args>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Node::Node(std::size_t hash,
+                                                                      const K    &key,
+                                                                      Args &&...args)
+    : m_hash(hash)
+    , m_value(std::piecewise_construct, std::forward_as_tuple(key),
+              std::forward_as_tuple(std::forward<Args>(args)...)) {}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::concurrent_unordered_map(
+    size_type bucket_count, const Hash &hash, const KeyEqual &equal, const Allocator &alloc)
+    : m_hash(hash)
+    , m_equal(equal)
+    , m_alloc(alloc)
+    , m_nodeAlloc(alloc)
+    , m_bucketAlloc(alloc)
+    , m_tableAlloc(alloc)
+    , m_stripeCount(stripeCount())
+    , m_stripes(std::make_unique<Stripe[]>(m_stripeCount))
+    , m_table(newTable(std::max(std::bit_ceil(bucket_count), m_stripeCount)))
+    , m_bucketCount(m_table.load(std::memory_order_relaxed)->m_count) {}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::concurrent_unordered_map(
+    const Allocator &alloc)
+    : concurrent_unordered_map(0, Hash(), KeyEqual(), alloc) {}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::~concurrent_unordered_map() {
+    clear();
+    deleteTable(m_table.load(std::memory_order_relaxed));
+    deleteTable(m_next.load(std::memory_order_relaxed));
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::allocator_type
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::get_allocator() const noexcept {
+    return m_alloc;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] std::optional<V>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::find(const K &key) const {
+    std::optional<V> res;
+    visit(key, [&res](const V &value) { res.emplace(value); });
+    return res;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] bool
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::contains(const K &key) const {
+    return visit(key, [](const V &) {});
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class F>
+    requires std::invocable<F &, const V &>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::visit(const K &key, F &&f) const {
+    std::size_t       hash = hashOf(key);
+    std::shared_lock  guard(stripeOf(hash).m_mutex);
+    Node             *node = *locate(bucketOf(hash), hash, key);
+    if (nullptr == node) {
+        return false;
+    }
+    std::invoke(f, std::as_const(node->m_value.second));
+    return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class F>
+    requires std::invocable<F &, const std::pair<const K, V> &>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::for_each(F &&f) const {
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        std::shared_lock guard(m_stripes[stripe].m_mutex);
+        for (Table *table : {m_table.load(std::memory_order_acquire),
+                             m_next.load(std::memory_order_acquire)}) {
+            if (nullptr == table) {
+                continue;
+            }
+            for (size_type index = stripe; index < table->m_count; index += m_stripeCount) {
+                for (Node *node = table->m_buckets[index].m_head; nullptr != node;
+                     node       = node->m_next) {
+                    std::invoke(f, std::as_const(node->m_value));
+                }
+            }
+        }
+    }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class... Args>
+    requires std::constructible_from<V, Args...>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::try_emplace(const K &key,
+                                                                            Args &&...args) {
+    std::size_t hash   = hashOf(key);
+    Stripe     &stripe = stripeOf(hash);
+    bool        grows  = false;
+    {
+        std::unique_lock guard(stripe.m_mutex);
+        Bucket          &bucket = bucketOf(hash);
+        if (nullptr != *locate(bucket, hash, key)) {
+            return false;
+        }
+        link(stripe, bucket, newNode(hash, key, std::forward<Args>(args)...));
+        grows = crowded(stripe);
+    }
+
+    if (grows) {
+        grow();
+    }
+    helpMigrate();
+    return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class M>
+    requires std::assignable_from<V &, M> && std::constructible_from<V, M>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::insert_or_assign(const K &key,
+                                                                                 M       &&obj) {
+    std::size_t hash   = hashOf(key);
+    Stripe     &stripe = stripeOf(hash);
+    bool        grows  = false;
+    {
+        std::unique_lock guard(stripe.m_mutex);
+        Bucket          &bucket = bucketOf(hash);
+        Node            *node   = *locate(bucket, hash, key);
+        if (nullptr != node) {
+            node->m_value.second = std::forward<M>(obj);
+            return false;
+        }
+        link(stripe, bucket, newNode(hash, key, std::forward<M>(obj)));
+        grows = crowded(stripe);
+    }
+
+    if (grows) {
+        grow();
+    }
+    helpMigrate();
+    return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class F>
+    requires std::invocable<F &> && std::constructible_from<V, std::invoke_result_t<F &>>
+V concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::compute_if_absent(const K &key,
+                                                                               F       &&f) {
+    std::size_t      hash   = hashOf(key);
+    Stripe          &stripe = stripeOf(hash);
+    std::unique_lock guard(stripe.m_mutex);
+    Bucket          &bucket = bucketOf(hash);
+    Node            *node   = *locate(bucket, hash, key);
+    if (nullptr != node) {
+        return node->m_value.second;
+    }
+
+    node = newNode(hash, key, std::invoke(f));
+    link(stripe, bucket, node);
+    V    res   = node->m_value.second;
+    bool grows = crowded(stripe);
+    guard.unlock();
+
+    if (grows) {
+        grow();
+    }
+    helpMigrate();
+    return res;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::erase(const K &key) {
+    std::size_t hash   = hashOf(key);
+    Stripe     &stripe = stripeOf(hash);
+    Node       *node   = nullptr;
+    {
+        std::unique_lock guard(stripe.m_mutex);
+        Node           **link = locate(bucketOf(hash), hash, key);
+        node                  = *link;
+        if (nullptr == node) {
+            return false;
+        }
+        *link = node->m_next;
+        stripe.m_count.store(stripe.m_count.load(std::memory_order_relaxed) - 1,
+                             std::memory_order_relaxed);
+    }
+
+    deleteNode(node);
+    helpMigrate();
+    return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::clear() {
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        m_stripes[stripe].m_mutex.lock();
+    }
+
+    for (Table *table :
+         {m_table.load(std::memory_order_relaxed), m_next.load(std::memory_order_relaxed)}) {
+        for (size_type index = 0; nullptr != table && index < table->m_count; ++index) {
+            Node *node = std::exchange(table->m_buckets[index].m_head, nullptr);
+            while (nullptr != node) {
+                deleteNode(std::exchange(node, node->m_next));
+            }
+        }
+    }
+
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        m_stripes[stripe].m_count.store(0, std::memory_order_relaxed);
+        m_stripes[stripe].m_mutex.unlock();
+    }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::size_type
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::size() const noexcept {
+    size_type count = 0;
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        count += m_stripes[stripe].m_count.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] bool
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::empty() const noexcept {
+    return 0 == size();
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+[[nodiscard]] concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::size_type
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::bucket_count() const noexcept {
+    return m_bucketCount.load(std::memory_order_relaxed);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+std::size_t
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::mix(std::size_t hash) noexcept {
+    // identity hashes would otherwise pile consecutive keys onto one stripe
+    std::uint64_t x = hash;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::size_type
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::stripeCount() noexcept {
+    auto threads = static_cast<size_type>(std::max(1U, std::thread::hardware_concurrency()));
+    return std::clamp<size_type>(std::bit_ceil(4 * threads), 16, 1024);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+std::size_t concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::hashOf(const K &key) const {
+    return mix(m_hash(key));
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+typename concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Stripe &
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::stripeOf(
+    std::size_t hash) const noexcept {
+    return m_stripes[hash & (m_stripeCount - 1)];
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+typename concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Bucket &
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::bucketOf(
+    std::size_t hash) const noexcept {
+    // the bucket count is a multiple of the stripe count, so a bucket and both of its halves
+    // after a split share the stripe whose lock the caller holds
+    Table  *table  = m_table.load(std::memory_order_acquire);
+    Bucket &bucket = table->m_buckets[hash & (table->m_count - 1)];
+    if (!bucket.m_moved) {
+        return bucket;
+    }
+    Table *next = m_next.load(std::memory_order_acquire);
+    return next->m_buckets[hash & (next->m_count - 1)];
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+typename concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Node **
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::locate(Bucket &bucket, std::size_t hash,
+                                                                   const K &key) const {
+    Node **link = &bucket.m_head;
+    while (nullptr != *link && !((*link)->m_hash == hash && m_equal((*link)->m_value.first, key))) {
+        link = &(*link)->m_next;
+    }
+    return link;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+template <class... Args>
+typename concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Node *
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::newNode(std::size_t hash, const K &key,
+                                                                    Args &&...args) {
+    Node *node = AllocatorTraitsNode::allocate(m_nodeAlloc, 1);
+    try {
+        AllocatorTraitsNode::construct(m_nodeAlloc, node, hash, key, std::forward<Args>(args)...);
+    } catch (...) {
+        AllocatorTraitsNode::deallocate(m_nodeAlloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::deleteNode(Node *node) noexcept {
+    AllocatorTraitsNode::destroy(m_nodeAlloc, node);
+    AllocatorTraitsNode::deallocate(m_nodeAlloc, node, 1);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+typename concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::Table *
+concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::newTable(size_type count) {
+    Bucket *buckets = AllocatorTraitsBucket::allocate(m_bucketAlloc, count);
+    std::uninitialized_default_construct_n(buckets, count);
+    try {
+        Table *table = AllocatorTraitsTable::allocate(m_tableAlloc, 1);
+        AllocatorTraitsTable::construct(m_tableAlloc, table, count, buckets);
+        return table;
+    } catch (...) {
+        AllocatorTraitsBucket::deallocate(m_bucketAlloc, buckets, count);
+        throw;
+    }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::deleteTable(Table *table) noexcept {
+    if (nullptr == table) {
+        return;
+    }
+    AllocatorTraitsBucket::deallocate(m_bucketAlloc, table->m_buckets, table->m_count);
+    AllocatorTraitsTable::destroy(m_tableAlloc, table);
+    AllocatorTraitsTable::deallocate(m_tableAlloc, table, 1);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::link(Stripe &stripe, Bucket &bucket,
+                                                                     Node *node) noexcept {
+    node->m_next  = bucket.m_head;
+    bucket.m_head = node;
+    stripe.m_count.store(stripe.m_count.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::crowded(
+    const Stripe &stripe) const noexcept {
+    return stripe.m_count.load(std::memory_order_relaxed) > bucket_count() / m_stripeCount &&
+           nullptr == m_next.load(std::memory_order_relaxed);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::grow() {
+    size_type count = bucket_count();
+    Table    *next  = nullptr;
+    try {
+        next = newTable(2 * count);
+    } catch (const std::bad_alloc &) {
+        return;
+    }
+
+    {
+        // holding any stripe keeps finishMigration, which takes them all, from running
+        std::unique_lock guard(m_stripes[0].m_mutex);
+        Table           *expected = nullptr;
+        if (count == bucket_count() &&
+            m_next.compare_exchange_strong(expected, next, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+            next = nullptr;
+        }
+    }
+    deleteTable(next);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+bool concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::migrate(size_type stripe) noexcept {
+    Table *table = m_table.load(std::memory_order_relaxed);
+    Table *next  = m_next.load(std::memory_order_acquire);
+    if (nullptr == next) {
+        return false;
+    }
+
+    size_type &cursor = m_stripes[stripe].m_cursor;
+    size_type  total  = table->m_count / m_stripeCount;
+    if (cursor >= total) {
+        return false;
+    }
+
+    for (size_type end = std::min(total, cursor + MIGRATE_CHUNK); cursor < end; ++cursor) {
+        Bucket &old  = table->m_buckets[stripe + cursor * m_stripeCount];
+        Node   *node = std::exchange(old.m_head, nullptr);
+        while (nullptr != node) {
+            Node   *following = std::exchange(node->m_next, nullptr);
+            Bucket &target    = next->m_buckets[node->m_hash & (next->m_count - 1)];
+            node->m_next      = target.m_head;
+            target.m_head     = node;
+            node              = following;
+        }
+        old.m_moved = true;
+    }
+    return cursor == total &&
+           m_migrated.fetch_add(1, std::memory_order_acq_rel) + 1 == m_stripeCount;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::helpMigrate() noexcept {
+    if (nullptr == m_next.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    size_type stripe = m_helpCursor.fetch_add(1, std::memory_order_relaxed) & (m_stripeCount - 1);
+    bool      last   = false;
+    {
+        std::unique_lock guard(m_stripes[stripe].m_mutex);
+        last = migrate(stripe);
+    }
+    if (last) {
+        finishMigration();
+    }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Allocator>
+void concurrent_unordered_map<K, V, Hash, KeyEqual, Allocator>::finishMigration() noexcept {
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        m_stripes[stripe].m_mutex.lock();
+    }
+
+    Table *old  = m_table.load(std::memory_order_relaxed);
+    Table *next = m_next.load(std::memory_order_relaxed);
+    m_table.store(next, std::memory_order_release);
+    m_next.store(nullptr, std::memory_order_release);
+    m_bucketCount.store(next->m_count, std::memory_order_relaxed);
+    m_migrated.store(0, std::memory_order_relaxed);
+    for (size_type stripe = 0; stripe < m_stripeCount; ++stripe) {
+        m_stripes[stripe].m_cursor = 0;
+        m_stripes[stripe].m_mutex.unlock();
+    }
+    deleteTable(old);
+}
+} // namespace ext
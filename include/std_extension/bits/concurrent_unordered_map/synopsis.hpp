@@ -0,0 +1,140 @@
+#pragma once
+
+#include "std_extension/memory.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+namespace ext {
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>,
+          class Allocator = ext::allocator<std::pair<const K, V>>>
+class concurrent_unordered_map final {
+public:
+    using key_type       = K;
+    using mapped_type    = V;
+    using value_type     = std::pair<const K, V>;
+    using size_type      = std::size_t;
+    using hasher         = Hash;
+    using key_equal      = KeyEqual;
+    using allocator_type = Allocator;
+
+    explicit concurrent_unordered_map(size_type        bucket_count = 0,
+                                      const Hash      &hash         = Hash(),
+                                      const KeyEqual  &equal        = KeyEqual(),
+                                      const Allocator &alloc        = Allocator());
+
+    explicit concurrent_unordered_map(const Allocator &alloc);
+
+    concurrent_unordered_map(const concurrent_unordered_map &)            = delete;
+    concurrent_unordered_map &operator=(const concurrent_unordered_map &) = delete;
+
+    ~concurrent_unordered_map();
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+    [[nodiscard]] std::optional<V> find(const K &key) const;
+    [[nodiscard]] bool             contains(const K &key) const;
+
+    template <class F>
+        requires std::invocable<F &, const V &>
+    bool visit(const K &key, F &&f) const;
+
+    template <class F>
+        requires std::invocable<F &, const std::pair<const K, V> &>
+    void for_each(F &&f) const;
+
+    template <class... Args>
+        requires std::constructible_from<V, Args...>
+    bool try_emplace(const K &key, Args &&...args);
+
+    template <class M>
+        requires std::assignable_from<V &, M> && std::constructible_from<V, M>
+    bool insert_or_assign(const K &key, M &&obj);
+
+    // f runs under the key's stripe lock and must not call back into the map
+    template <class F>
+        requires std::invocable<F &> && std::constructible_from<V, std::invoke_result_t<F &>>
+    V compute_if_absent(const K &key, F &&f);
+
+    bool erase(const K &key);
+    void clear();
+
+    // approximate while writers are running
+    [[nodiscard]] size_type size() const noexcept;
+    [[nodiscard]] bool      empty() const noexcept;
+    [[nodiscard]] size_type bucket_count() const noexcept;
+
+private:
+    struct Node {
+        template <class... Args> Node(std::size_t hash, const K &key, Args &&...args);
+
+        Node       *m_next = nullptr;
+        std::size_t m_hash;
+        value_type  m_value;
+    };
+
+    struct Bucket {
+        Node *m_head  = nullptr;
+        bool  m_moved = false;
+    };
+
+    struct Table {
+        size_type m_count;
+        Bucket   *m_buckets;
+    };
+
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex m_mutex;
+        std::atomic<size_type>    m_count  = 0; // written under the lock, summed without it
+        size_type                 m_cursor = 0; // next old bucket to migrate, in stripe units
+    };
+
+    using AllocatorNode         = typename std::allocator_traits<Allocator>::rebind_alloc<Node>;
+    using AllocatorTraitsNode   = typename std::allocator_traits<Allocator>::rebind_traits<Node>;
+    using AllocatorBucket       = typename std::allocator_traits<Allocator>::rebind_alloc<Bucket>;
+    using AllocatorTraitsBucket = typename std::allocator_traits<Allocator>::rebind_traits<Bucket>;
+    using AllocatorTable        = typename std::allocator_traits<Allocator>::rebind_alloc<Table>;
+    using AllocatorTraitsTable  = typename std::allocator_traits<Allocator>::rebind_traits<Table>;
+
+    static constexpr size_type MIGRATE_CHUNK = 8;
+
+    static std::size_t mix(std::size_t hash) noexcept;
+    static size_type   stripeCount() noexcept;
+
+    std::size_t hashOf(const K &key) const;
+    Stripe     &stripeOf(std::size_t hash) const noexcept;
+    Bucket     &bucketOf(std::size_t hash) const noexcept;
+    Node      **locate(Bucket &bucket, std::size_t hash, const K &key) const;
+
+    template <class... Args> Node *newNode(std::size_t hash, const K &key, Args &&...args);
+    void                           deleteNode(Node *node) noexcept;
+    Table                         *newTable(size_type count);
+    void                           deleteTable(Table *table) noexcept;
+
+    void link(Stripe &stripe, Bucket &bucket, Node *node) noexcept;
+    bool crowded(const Stripe &stripe) const noexcept;
+    void grow();
+    bool migrate(size_type stripe) noexcept;
+    void helpMigrate() noexcept;
+    void finishMigration() noexcept;
+
+    [[no_unique_address]] Hash            m_hash;
+    [[no_unique_address]] KeyEqual        m_equal;
+    [[no_unique_address]] Allocator       m_alloc;
+    [[no_unique_address]] AllocatorNode   m_nodeAlloc;
+    [[no_unique_address]] AllocatorBucket m_bucketAlloc;
+    [[no_unique_address]] AllocatorTable  m_tableAlloc;
+    const size_type                       m_stripeCount;
+    std::unique_ptr<Stripe[]>             m_stripes;
+    std::atomic<Table *>                  m_table;
+    std::atomic<Table *>                  m_next        = nullptr;
+    std::atomic<size_type>                m_bucketCount = 0;
+    std::atomic<size_type>                m_migrated    = 0;
+    std::atomic<size_type>                m_helpCursor  = 0;
+};
+} // namespace ext
@@ -2,23 +2,43 @@
 
 #include "std_extension/deferred_task.hpp"
 #include "std_extension/interrupted_exception.hpp"
+#include "std_extension/parking_lot.hpp"
 #include "std_extension/thread.hpp"
 #include "synopsis.hpp"
 
+#include <memory>
 #include <utility>
 
 namespace ext {
+template <class Clock, class Duration>
+std::cv_status
+condition_variable::waitUntil(std::unique_lock<std::mutex>                   &lock,
+                              const std::chrono::time_point<Clock, Duration> *abs_time) {
+    deferred_task relock([&lock] {
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+    });
+
+    auto validate = [this] {
+        m_hasWaiters.store(true, std::memory_order_relaxed);
+        return true;
+    };
+    auto before_sleep = [&lock] { lock.unlock(); };
+
+    park_result res = nullptr == abs_time
+                          ? parking_lot::park(this, 0, validate, before_sleep)
+                          : parking_lot::park_until(this, 0, validate, before_sleep, *abs_time);
+    return park_result::TIMEOUT == res ? std::cv_status::timeout : std::cv_status::no_timeout;
+}
+
 template <class Pred> void condition_variable::wait(std::unique_lock<std::mutex> &lock, Pred pred) {
-    std::shared_ptr<thread::Spore> spore = thread::get_spore();
+    thread::Spore *spore = thread::get_spore();
     if (nullptr != spore) {
-        auto defer = registerCV(*spore);
-        checkInterrupted(*spore);
-        while (!pred()) {
-            m_cv.wait(lock);
-            checkInterrupted(*spore);
-        }
-    } else {
-        m_cv.wait(lock, std::move(pred));
+        thread::checkInterrupted(*spore);
+    }
+    while (!pred()) {
+        wait(lock);
     }
 }
 
@@ -26,35 +46,23 @@ template <class Clock, class Duration>
 std::cv_status
 condition_variable::wait_until(std::unique_lock<std::mutex>                   &lock,
                                const std::chrono::time_point<Clock, Duration> &abs_time) {
-    std::shared_ptr<thread::Spore> spore = thread::get_spore();
-    if (nullptr != spore) {
-        auto defer = registerCV(*spore);
-        checkInterrupted(*spore);
-        auto res = m_cv.wait_until(lock, abs_time);
-        checkInterrupted(*spore);
-        return res;
-    } else {
-        return m_cv.wait_until(lock, abs_time);
-    }
+    return waitUntil(lock, std::addressof(abs_time));
 }
 
 template <class Clock, class Duration, class Pred>
 bool condition_variable::wait_until(std::unique_lock<std::mutex>                   &lock,
                                     const std::chrono::time_point<Clock, Duration> &abs_time,
                                     Pred                                            pred) {
-    std::shared_ptr<thread::Spore> spore = thread::get_spore();
+    thread::Spore *spore = thread::get_spore();
     if (nullptr != spore) {
-        auto defer = registerCV(*spore);
-        checkInterrupted(*spore);
-        std::cv_status status = std::cv_status::no_timeout;
-        while (!pred() && std::cv_status::no_timeout == status) {
-            status = m_cv.wait_until(lock, abs_time);
-            checkInterrupted(*spore);
+        thread::checkInterrupted(*spore);
+    }
+    while (!pred()) {
+        if (std::cv_status::timeout == wait_until(lock, abs_time)) {
+            return pred();
         }
-        return pred();
-    } else {
-        return m_cv.wait_until(lock, abs_time, std::move(pred));
     }
+    return true;
 }
 
 template <class Rep, class Period>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
@@ -7,7 +8,7 @@
 namespace ext {
 class condition_variable final {
 public:
-    condition_variable()  = default;
+    condition_variable() noexcept;
     ~condition_variable() = default;
 
     condition_variable(const condition_variable &)            = delete;
@@ -35,26 +36,11 @@ public:
     bool wait_for(std::unique_lock<std::mutex>             &lock,
                   const std::chrono::duration<Rep, Period> &rel_time, Pred pred);
 
-    std::condition_variable::native_handle_type native_handle();
-
 private:
-    struct Defer final {
-        explicit Defer(thread::Spore &spore) noexcept;
-
-        Defer(const Defer &)            = default;
-        Defer &operator=(const Defer &) = default;
-
-        ~Defer() = default;
-
-        void operator()() noexcept;
-
-    private:
-        thread::Spore &m_spore;
-    };
-
-    static void                        checkInterrupted(thread::Spore &spore);
-    [[nodiscard]] deferred_task<Defer> registerCV(thread::Spore &spore) noexcept;
+    template <class Clock, class Duration>
+    std::cv_status waitUntil(std::unique_lock<std::mutex>                   &lock,
+                             const std::chrono::time_point<Clock, Duration> *abs_time);
 
-    std::condition_variable m_cv;
+    std::atomic_bool m_hasWaiters;
 };
 } // namespace ext
@@ -1,12 +1,20 @@
 #pragma once
 
+#include "std_extension/parking_lot.hpp"
 #include "synopsis.hpp"
 
 namespace ext {
 template <class Clock, class Duration>
 bool countdown_latch::wait_until(const std::chrono::time_point<Clock, Duration> &abs_time) const {
-    std::unique_lock lock(m_mutex);
-    return m_cv.wait_until(lock, abs_time, [this] { return 0 == m_count; });
+    while (0 != m_count.load(std::memory_order_acquire)) {
+        park_result res = parking_lot::park_until(
+            this, 0, [this] { return 0 != m_count.load(std::memory_order_relaxed); }, [] {},
+            abs_time);
+        if (park_result::TIMEOUT == res) {
+            return 0 == m_count.load(std::memory_order_acquire);
+        }
+    }
+    return true;
 }
 
 template <class Rep, class Period>
@@ -1,10 +1,8 @@
 #pragma once
 
-#include "std_extension/condition_variable.hpp"
-
+#include <atomic>
 #include <chrono>
 #include <cstddef>
-#include <mutex>
 
 namespace ext {
 class countdown_latch final {
@@ -27,8 +25,6 @@ public:
     std::size_t count() const noexcept;
 
 private:
-    std::size_t                m_count;
-    mutable std::mutex         m_mutex;
-    mutable condition_variable m_cv;
+    std::atomic_size_t m_count;
 };
 } // namespace ext
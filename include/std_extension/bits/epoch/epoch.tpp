@@ -0,0 +1,12 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+namespace ext {
+template <class T, class D>
+    requires std::is_empty_v<D> && std::default_initializable<D>
+void epoch::retire(T *p) {
+    retire(const_cast<void *>(static_cast<const volatile void *>(p)),
+           [](void *object) { D()(static_cast<T *>(object)); });
+}
+} // namespace ext
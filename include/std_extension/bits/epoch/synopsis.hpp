@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace ext {
+namespace detail {
+struct epoch_record;
+
+struct epoch_retired {
+    void         *m_object;
+    void        (*m_reclaim)(void *);
+    std::uint64_t m_epoch;
+};
+} // namespace detail
+
+class epoch final {
+public:
+    class guard final {
+    public:
+        guard(const guard &)            = delete;
+        guard &operator=(const guard &) = delete;
+
+        guard(guard &&other) noexcept;
+
+        ~guard();
+
+    private:
+        friend class epoch;
+
+        guard(epoch &domain, detail::epoch_record *record, bool release) noexcept;
+
+        epoch                *m_domain;
+        detail::epoch_record *m_record;
+        bool                  m_release;
+    };
+
+    epoch();
+
+    epoch(const epoch &)            = delete;
+    epoch &operator=(const epoch &) = delete;
+
+    // every thread must be unpinned and done retiring into this domain
+    ~epoch();
+
+    static epoch &global() noexcept;
+
+    [[nodiscard]] guard pin();
+
+    template <class T, class D = std::default_delete<T>>
+        requires std::is_empty_v<D> && std::default_initializable<D>
+    void retire(T *p);
+
+    void retire(void *p, void (*reclaim)(void *));
+
+    void collect();
+
+private:
+    detail::epoch_record *acquireRecord();
+    void                  releaseRecord(detail::epoch_record *record) noexcept;
+    detail::epoch_record *threadRecord();
+    bool                  tryAdvance() noexcept;
+    void                  reclaim(std::vector<detail::epoch_retired> &retired) noexcept;
+    void                  unpin(detail::epoch_record *record) noexcept;
+
+    friend struct detail::epoch_record;
+
+    const std::uint64_t                 m_id;
+    alignas(64) std::atomic_uint64_t    m_epoch   = 0;
+    std::atomic<detail::epoch_record *> m_records = nullptr;
+    std::mutex                          m_mutex;
+    std::vector<detail::epoch_retired>  m_orphans;
+};
+} // namespace ext
@@ -68,6 +68,7 @@ executor::emplace(EmplaceAt position, F &&f, Args &&...args) {
         });
     }
 
+    wakeOne();
     --m_activeness;
     return res;
 }
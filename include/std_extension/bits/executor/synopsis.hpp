@@ -4,17 +4,30 @@
 #include "std_extension/thread.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <concepts>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 #include <vector>
 
 namespace ext {
+enum class wakeup_order {
+    FIFO,
+    LIFO,
+};
+
+struct idle_policy {
+    wakeup_order             order    = wakeup_order::LIFO;
+    std::chrono::nanoseconds spin_for = std::chrono::nanoseconds::zero();
+};
+
 class executor final {
 public:
-    executor(std::size_t nthreads = 1);
+    executor(std::size_t nthreads = 1, idle_policy policy = idle_policy());
 
     executor(const executor &)            = delete;
     executor &operator=(const executor &) = delete;
@@ -56,8 +69,38 @@ private:
         CONTINUE,
         STOP,
     };
-    std::atomic_long                                 m_activeness;
-    std::vector<thread>                              m_workers;
-    blocking_deque<std::move_only_function<State()>> m_tasks;
+
+    using Task = std::move_only_function<State()>;
+
+    struct Idler {
+        Idler();
+
+        Idler(const Idler &)            = delete;
+        Idler &operator=(const Idler &) = delete;
+
+        ~Idler() = default;
+
+        bool             m_idle;
+        Idler           *m_next;
+        Idler           *m_prev;
+        binary_semaphore m_sem;
+    };
+
+    [[nodiscard]] std::shared_ptr<Task> next(Idler &idler);
+
+    void   wakeOne();
+    void   enqueue(Idler *idler) noexcept;
+    Idler *dequeue() noexcept;
+    void   remove(Idler *idler) noexcept;
+
+    const idle_policy                   m_policy;
+    std::atomic_long                    m_activeness;
+    std::atomic_size_t                  m_nidle;
+    Idler                              *m_head;
+    Idler                              *m_tail;
+    std::mutex                          m_idleMutex;
+    std::vector<std::unique_ptr<Idler>> m_idlers;
+    std::vector<thread>                 m_workers;
+    blocking_deque<Task>                m_tasks;
 };
 } // namespace ext
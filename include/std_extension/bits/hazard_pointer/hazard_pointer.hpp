@@ -0,0 +1,3 @@
+#pragma once
+
+#include "hazard_pointer.tpp"
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <utility>
+
+namespace ext {
+template <class T, class D> void hazard_pointer_obj_base<T, D>::retire(D d) noexcept {
+    m_deleter = std::move(d);
+    m_object  = static_cast<const void *>(static_cast<const T *>(this));
+    m_reclaim = &reclaim;
+    detail::hazard_retire(this);
+}
+
+template <class T, class D>
+void hazard_pointer_obj_base<T, D>::reclaim(detail::hazard_retired *retired) noexcept {
+    auto *self    = static_cast<hazard_pointer_obj_base *>(retired);
+    D     deleter = std::move(self->m_deleter);
+    deleter(static_cast<T *>(self));
+}
+
+template <class T> T *hazard_pointer::protect(const std::atomic<T *> &src) noexcept {
+    T *p = src.load(std::memory_order_relaxed);
+    while (!try_protect(p, src)) {
+    }
+    return p;
+}
+
+template <class T>
+bool hazard_pointer::try_protect(T *&ptr, const std::atomic<T *> &src) noexcept {
+    T *expected = ptr;
+    reset_protection(expected);
+    ptr = src.load(std::memory_order_acquire);
+    if (expected != ptr) {
+        reset_protection();
+        return false;
+    }
+    return true;
+}
+
+template <class T> void hazard_pointer::reset_protection(const T *ptr) noexcept {
+    detail::hazard_protect(m_record, static_cast<const void *>(ptr));
+}
+} // namespace ext
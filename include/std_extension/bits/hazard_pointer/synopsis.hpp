@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace ext {
+namespace detail {
+struct hazard_record;
+
+struct hazard_retired {
+    const void     *m_object  = nullptr;
+    hazard_retired *m_next    = nullptr;
+    void          (*m_reclaim)(hazard_retired *) noexcept = nullptr;
+};
+
+hazard_record *hazard_acquire();
+void           hazard_release(hazard_record *record) noexcept;
+void           hazard_protect(hazard_record *record, const void *p) noexcept;
+void           hazard_retire(hazard_retired *retired) noexcept;
+bool           hazard_protected(const void *p) noexcept;
+} // namespace detail
+
+template <class T, class D = std::default_delete<T>>
+class hazard_pointer_obj_base : private detail::hazard_retired {
+public:
+    void retire(D d = D()) noexcept;
+
+protected:
+    hazard_pointer_obj_base()                                    = default;
+    hazard_pointer_obj_base(const hazard_pointer_obj_base &)     = default;
+    hazard_pointer_obj_base(hazard_pointer_obj_base &&) noexcept = default;
+
+    hazard_pointer_obj_base &operator=(const hazard_pointer_obj_base &)     = default;
+    hazard_pointer_obj_base &operator=(hazard_pointer_obj_base &&) noexcept = default;
+
+    ~hazard_pointer_obj_base() = default;
+
+private:
+    static void reclaim(detail::hazard_retired *retired) noexcept;
+
+    [[no_unique_address]] D m_deleter;
+};
+
+class hazard_pointer final {
+public:
+    hazard_pointer() noexcept = default;
+
+    hazard_pointer(const hazard_pointer &)            = delete;
+    hazard_pointer &operator=(const hazard_pointer &) = delete;
+
+    hazard_pointer(hazard_pointer &&other) noexcept;
+    hazard_pointer &operator=(hazard_pointer &&other) noexcept;
+
+    ~hazard_pointer();
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    template <class T> T   *protect(const std::atomic<T *> &src) noexcept;
+    template <class T> bool try_protect(T *&ptr, const std::atomic<T *> &src) noexcept;
+
+    template <class T> void reset_protection(const T *ptr) noexcept;
+    void                    reset_protection(std::nullptr_t = nullptr) noexcept;
+
+    void swap(hazard_pointer &other) noexcept;
+
+private:
+    friend hazard_pointer make_hazard_pointer();
+
+    explicit hazard_pointer(detail::hazard_record *record) noexcept;
+
+    detail::hazard_record *m_record = nullptr;
+};
+
+hazard_pointer make_hazard_pointer();
+
+void swap(hazard_pointer &lhs, hazard_pointer &rhs) noexcept;
+} // namespace ext
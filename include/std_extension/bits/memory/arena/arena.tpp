@@ -0,0 +1,57 @@
+#pragma once
+
+#include "std_extension/bits/memory/allocator/allocator.hpp"
+#include "synopsis.hpp"
+
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace ext {
+template <class E>
+constexpr arena_allocator<E>::arena_allocator(arena &arena) noexcept
+    : m_arena(std::addressof(arena)) {}
+
+template <class E>
+template <class U>
+constexpr arena_allocator<E>::arena_allocator(const arena_allocator<U> &other) noexcept
+    : m_arena(other.resource()) {}
+
+template <class E> constexpr arena_allocator<E>::size_type arena_allocator<E>::max_size() noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(E);
+}
+
+template <class E> [[nodiscard]] E *arena_allocator<E>::allocate(size_type n) {
+    static_assert(sizeof(E) > 0, "cannot allocate incomplete types");
+
+    if (n > max_size()) {
+        throw std::bad_array_new_length();
+    }
+    return static_cast<E *>(m_arena->allocate(n * sizeof(E), alignof(E)));
+}
+
+template <class E> void arena_allocator<E>::deallocate(E *, size_type) noexcept {}
+
+template <class E>
+template <class U, class... Args>
+    requires std::convertible_to<U *, E *>
+constexpr void arena_allocator<E>::construct(U *p, Args &&...args) {
+    ext::construct_at(p, std::forward<Args>(args)...);
+}
+
+template <class E>
+template <class U>
+    requires std::convertible_to<U *, E *>
+constexpr void arena_allocator<E>::destroy(U *p) {
+    ext::destroy_at(p);
+}
+
+template <class E> constexpr arena *arena_allocator<E>::resource() const noexcept {
+    return m_arena;
+}
+
+template <class E, class U>
+constexpr bool operator==(const arena_allocator<E> &lhs, const arena_allocator<U> &rhs) noexcept {
+    return lhs.resource() == rhs.resource();
+}
+} // namespace ext
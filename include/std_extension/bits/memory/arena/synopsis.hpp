@@ -0,0 +1,96 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+
+namespace ext {
+// Not synchronized: an arena, and every arena_allocator over it, must be used by one thread at a
+// time. Containers whose elements are allocated and released on different threads, such as a
+// blocking_deque shared by producers and consumers, need a per-thread arena or another resource.
+class arena final : public std::pmr::memory_resource {
+public:
+    explicit arena(std::size_t                 initial_size = 4096,
+                   std::pmr::memory_resource *upstream     = std::pmr::new_delete_resource());
+
+    arena(const arena &)            = delete;
+    arena &operator=(const arena &) = delete;
+
+    ~arena() override;
+
+    void reset() noexcept;
+    void release() noexcept;
+
+    [[nodiscard]] std::size_t                capacity() const noexcept;
+    [[nodiscard]] std::pmr::memory_resource *upstream_resource() const noexcept;
+
+private:
+    struct Block {
+        Block      *m_next;
+        std::size_t m_size;
+    };
+
+    static std::byte *begin(Block *block) noexcept;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    bool tryBump(std::size_t bytes, std::size_t alignment, void *&p) noexcept;
+
+    std::pmr::memory_resource *m_upstream;
+    const std::size_t          m_initialSize;
+    std::size_t                m_nextSize;
+    Block                     *m_head;
+    Block                     *m_tail;
+    Block                     *m_current;
+    std::byte                 *m_cursor;
+    std::byte                 *m_end;
+};
+
+template <class E> struct arena_allocator {
+public:
+    using value_type                             = E;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    constexpr arena_allocator(arena &arena) noexcept;
+    constexpr arena_allocator(const arena_allocator &) noexcept = default;
+
+    template <class U> constexpr arena_allocator(const arena_allocator<U> &other) noexcept;
+
+    constexpr arena_allocator &operator=(const arena_allocator &) = default;
+
+    constexpr ~arena_allocator() = default;
+
+    static constexpr size_type max_size() noexcept;
+
+    [[nodiscard]] E *allocate(size_type n);
+    void             deallocate(E *p, size_type n) noexcept;
+
+    template <class U, class... Args>
+        requires std::convertible_to<U *, E *>
+    constexpr void construct(U *p, Args &&...args);
+
+    template <class U>
+        requires std::convertible_to<U *, E *>
+    constexpr void destroy(U *p);
+
+    [[nodiscard]] constexpr arena *resource() const noexcept;
+
+    template <class U> struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+private:
+    arena *m_arena;
+};
+
+template <class E, class U>
+constexpr bool operator==(const arena_allocator<E> &lhs, const arena_allocator<U> &rhs) noexcept;
+} // namespace ext
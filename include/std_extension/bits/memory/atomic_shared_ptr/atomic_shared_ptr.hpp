@@ -0,0 +1,3 @@
+#pragma once
+
+#include "atomic_shared_ptr.tpp"
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <utility>
+
+namespace ext {
+template <class T>
+atomic_shared_ptr<T>::Holder::Holder(std::shared_ptr<T> ptr) noexcept
+    : m_ptr(std::move(ptr)) {}
+
+template <class T>
+atomic_shared_ptr<T>::atomic_shared_ptr(std::shared_ptr<T> desired)
+    : m_holder(hold(std::move(desired))) {}
+
+template <class T> atomic_shared_ptr<T>::~atomic_shared_ptr() {
+    delete m_holder.load(std::memory_order_relaxed);
+}
+
+template <class T> void atomic_shared_ptr<T>::operator=(std::shared_ptr<T> desired) {
+    store(std::move(desired));
+}
+
+template <class T> bool atomic_shared_ptr<T>::is_lock_free() const noexcept { return false; }
+
+template <class T>
+[[nodiscard]] std::shared_ptr<T> atomic_shared_ptr<T>::load(std::memory_order) const {
+    if (nullptr == m_holder.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    hazard_pointer hazard = make_hazard_pointer();
+    Holder        *holder = hazard.protect(m_holder);
+    return nullptr != holder ? holder->m_ptr : nullptr;
+}
+
+template <class T> atomic_shared_ptr<T>::operator std::shared_ptr<T>() const { return load(); }
+
+template <class T>
+void atomic_shared_ptr<T>::store(std::shared_ptr<T> desired, std::memory_order order) {
+    retire(m_holder.exchange(hold(std::move(desired)), order));
+}
+
+template <class T>
+std::shared_ptr<T> atomic_shared_ptr<T>::exchange(std::shared_ptr<T> desired,
+                                                  std::memory_order  order) {
+    Holder *previous = m_holder.exchange(hold(std::move(desired)), order);
+    if (nullptr == previous) {
+        return nullptr;
+    }
+
+    // other readers may still be copying out of the holder, so copy rather than move
+    std::shared_ptr<T> result = previous->m_ptr;
+    retire(previous);
+    return result;
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::compare_exchange_weak(std::shared_ptr<T> &expected,
+                                                 std::shared_ptr<T> desired,
+                                                 std::memory_order success, std::memory_order) {
+    return compareExchange(expected, std::move(desired), success);
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::compare_exchange_weak(std::shared_ptr<T> &expected,
+                                                 std::shared_ptr<T> desired,
+                                                 std::memory_order  order) {
+    return compareExchange(expected, std::move(desired), order);
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::compare_exchange_strong(std::shared_ptr<T> &expected,
+                                                   std::shared_ptr<T> desired,
+                                                   std::memory_order success, std::memory_order) {
+    return compareExchange(expected, std::move(desired), success);
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::compare_exchange_strong(std::shared_ptr<T> &expected,
+                                                   std::shared_ptr<T> desired,
+                                                   std::memory_order  order) {
+    return compareExchange(expected, std::move(desired), order);
+}
+
+template <class T>
+atomic_shared_ptr<T>::Holder *atomic_shared_ptr<T>::hold(std::shared_ptr<T> &&ptr) {
+    // the empty pointer is represented without a holder, so resetting never allocates
+    if (nullptr == ptr && ptr.use_count() == 0) {
+        return nullptr;
+    }
+    return new Holder(std::move(ptr));
+}
+
+template <class T> void atomic_shared_ptr<T>::retire(Holder *holder) noexcept {
+    if (nullptr == holder) {
+        return;
+    }
+    // release the old value right away unless a reader is still copying out of it
+    if (detail::hazard_protected(holder)) {
+        holder->retire();
+    } else {
+        delete holder;
+    }
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::equivalent(const std::shared_ptr<T> &lhs, const Holder *rhs) noexcept {
+    if (nullptr == rhs) {
+        return nullptr == lhs && lhs.use_count() == 0;
+    }
+    return lhs == rhs->m_ptr && !lhs.owner_before(rhs->m_ptr) && !rhs->m_ptr.owner_before(lhs);
+}
+
+template <class T>
+bool atomic_shared_ptr<T>::compareExchange(std::shared_ptr<T> &expected,
+                                           std::shared_ptr<T> &&desired,
+                                           std::memory_order   success) {
+    hazard_pointer hazard      = make_hazard_pointer();
+    Holder        *replacement = nullptr;
+    bool           prepared    = false;
+    while (true) {
+        Holder *current = hazard.protect(m_holder);
+        if (!equivalent(expected, current)) {
+            expected = nullptr != current ? current->m_ptr : nullptr;
+            delete replacement;
+            return false;
+        }
+
+        if (!prepared) {
+            replacement = hold(std::move(desired));
+            prepared    = true;
+        }
+
+        // current is protected, so its address cannot be recycled under this CAS
+        if (m_holder.compare_exchange_strong(current, replacement, success,
+                                             std::memory_order_relaxed)) {
+            hazard.reset_protection();
+            retire(current);
+            return true;
+        }
+    }
+}
+} // namespace ext
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "std_extension/hazard_pointer.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace ext {
+// A replaced value is released as soon as no reader is copying it out; otherwise it is released at
+// a later hazard pointer scan, so its use_count may briefly stay up after a store.
+template <class T> class atomic_shared_ptr final {
+public:
+    using value_type = std::shared_ptr<T>;
+
+    // loads never block, but writers allocate a holder and reclamation may take a lock
+    static constexpr bool is_always_lock_free = false;
+
+    constexpr atomic_shared_ptr() noexcept = default;
+    atomic_shared_ptr(std::shared_ptr<T> desired);
+
+    atomic_shared_ptr(const atomic_shared_ptr &)            = delete;
+    atomic_shared_ptr &operator=(const atomic_shared_ptr &) = delete;
+
+    ~atomic_shared_ptr();
+
+    void operator=(std::shared_ptr<T> desired);
+
+    [[nodiscard]] bool is_lock_free() const noexcept;
+
+    [[nodiscard]] std::shared_ptr<T>
+    load(std::memory_order order = std::memory_order_seq_cst) const;
+    operator std::shared_ptr<T>() const;
+
+    void store(std::shared_ptr<T> desired, std::memory_order order = std::memory_order_seq_cst);
+
+    std::shared_ptr<T> exchange(std::shared_ptr<T> desired,
+                                std::memory_order  order = std::memory_order_seq_cst);
+
+    bool compare_exchange_weak(std::shared_ptr<T> &expected, std::shared_ptr<T> desired,
+                               std::memory_order success, std::memory_order failure);
+    bool compare_exchange_weak(std::shared_ptr<T> &expected, std::shared_ptr<T> desired,
+                               std::memory_order order = std::memory_order_seq_cst);
+
+    bool compare_exchange_strong(std::shared_ptr<T> &expected, std::shared_ptr<T> desired,
+                                 std::memory_order success, std::memory_order failure);
+    bool compare_exchange_strong(std::shared_ptr<T> &expected, std::shared_ptr<T> desired,
+                                 std::memory_order order = std::memory_order_seq_cst);
+
+private:
+    // readers copy out of a holder under a hazard pointer, so the holder outlives every copy
+    struct Holder : hazard_pointer_obj_base<Holder> {
+        explicit Holder(std::shared_ptr<T> ptr) noexcept;
+
+        std::shared_ptr<T> m_ptr;
+    };
+
+    static Holder *hold(std::shared_ptr<T> &&ptr);
+    static void    retire(Holder *holder) noexcept;
+    static bool    equivalent(const std::shared_ptr<T> &lhs, const Holder *rhs) noexcept;
+
+    bool compareExchange(std::shared_ptr<T> &expected, std::shared_ptr<T> &&desired,
+                         std::memory_order success);
+
+    std::atomic<Holder *> m_holder = nullptr;
+};
+} // namespace ext
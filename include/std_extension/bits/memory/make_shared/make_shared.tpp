@@ -1,6 +1,5 @@
 #pragma once
 
-#include "std_extension/unexpected_deferred_task.hpp"
 #include "synopsis.hpp"
 
 #include <utility>
@@ -8,20 +7,18 @@
 namespace ext {
 template <class E, class Allocator, class... Args>
 std::shared_ptr<E> make_shared(const Allocator &alloc, Args &&...args) {
-    using AllocatorElement       = typename std::allocator_traits<Allocator>::rebind_alloc<E>;
-    using AllocatorTraitsElement = typename std::allocator_traits<Allocator>::rebind_traits<E>;
-    AllocatorElement         allocElement(alloc);
-    E                       *element = AllocatorTraitsElement::allocate(allocElement, 1);
-    unexpected_deferred_task unexpected(
-        [element, &allocElement] { AllocatorTraitsElement::deallocate(allocElement, element, 1); });
+    return std::allocate_shared<E>(alloc, std::forward<Args>(args)...);
+}
+
+template <class E, class Allocator>
+    requires(!std::is_unbounded_array_v<E>)
+std::shared_ptr<E> make_shared_for_overwrite(const Allocator &alloc) {
+    return std::allocate_shared_for_overwrite<E>(alloc);
+}
 
-    AllocatorTraitsElement::construct(allocElement, element, std::forward<Args>(args)...);
-    return std::shared_ptr<E>(
-        element,
-        [allocElement](E *element) mutable {
-            AllocatorTraitsElement::destroy(allocElement, element);
-            AllocatorTraitsElement::deallocate(allocElement, element, 1);
-        },
-        allocElement);
+template <class E, class Allocator>
+    requires std::is_unbounded_array_v<E>
+std::shared_ptr<E> make_shared_for_overwrite(const Allocator &alloc, std::size_t n) {
+    return std::allocate_shared_for_overwrite<E>(alloc, n);
 }
 } // namespace ext
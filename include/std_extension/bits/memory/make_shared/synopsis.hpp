@@ -1,8 +1,18 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <type_traits>
 
 namespace ext {
 template <class E, class Allocator, class... Args>
 std::shared_ptr<E> make_shared(const Allocator &alloc, Args &&...args);
-}
+
+template <class E, class Allocator>
+    requires(!std::is_unbounded_array_v<E>)
+std::shared_ptr<E> make_shared_for_overwrite(const Allocator &alloc);
+
+template <class E, class Allocator>
+    requires std::is_unbounded_array_v<E>
+std::shared_ptr<E> make_shared_for_overwrite(const Allocator &alloc, std::size_t n);
+} // namespace ext
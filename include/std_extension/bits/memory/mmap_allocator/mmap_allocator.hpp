@@ -0,0 +1,3 @@
+#pragma once
+
+#include "mmap_allocator.tpp"
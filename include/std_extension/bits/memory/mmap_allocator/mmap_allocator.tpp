@@ -0,0 +1,60 @@
+#pragma once
+
+#include "std_extension/bits/memory/allocator/allocator.hpp"
+#include "synopsis.hpp"
+
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace ext {
+template <class E>
+constexpr mmap_allocator<E>::mmap_allocator(mmap_options options) noexcept
+    : m_options(options) {}
+
+template <class E>
+template <class U>
+constexpr mmap_allocator<E>::mmap_allocator(const mmap_allocator<U> &other) noexcept
+    : m_options(other.options()) {}
+
+template <class E> constexpr mmap_allocator<E>::size_type mmap_allocator<E>::max_size() noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(E);
+}
+
+template <class E> [[nodiscard]] E *mmap_allocator<E>::allocate(size_type n) {
+    static_assert(sizeof(E) > 0, "cannot allocate incomplete types");
+    static_assert(alignof(E) <= 4096, "mmap_allocator is page aligned at most");
+
+    if (n > max_size()) {
+        throw std::bad_array_new_length();
+    }
+    return static_cast<E *>(detail::mmap_allocate(n * sizeof(E), alignof(E), m_options));
+}
+
+template <class E> void mmap_allocator<E>::deallocate(E *p, size_type n) noexcept {
+    detail::mmap_deallocate(p, n * sizeof(E), alignof(E), m_options);
+}
+
+template <class E>
+template <class U, class... Args>
+    requires std::convertible_to<U *, E *>
+constexpr void mmap_allocator<E>::construct(U *p, Args &&...args) {
+    ext::construct_at(p, std::forward<Args>(args)...);
+}
+
+template <class E>
+template <class U>
+    requires std::convertible_to<U *, E *>
+constexpr void mmap_allocator<E>::destroy(U *p) {
+    ext::destroy_at(p);
+}
+
+template <class E> constexpr const mmap_options &mmap_allocator<E>::options() const noexcept {
+    return m_options;
+}
+
+template <class E, class U>
+constexpr bool operator==(const mmap_allocator<E> &lhs, const mmap_allocator<U> &rhs) noexcept {
+    return lhs.options() == rhs.options();
+}
+} // namespace ext
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace ext {
+enum class huge_pages {
+    NONE,
+    TRANSPARENT,
+    EXPLICIT,
+};
+
+struct mmap_options {
+    huge_pages pages     = huge_pages::NONE;
+    int        numa_node = -1;
+
+    friend constexpr bool operator==(const mmap_options &, const mmap_options &) = default;
+};
+
+namespace detail {
+void *mmap_allocate(std::size_t bytes, std::size_t alignment, const mmap_options &options);
+void  mmap_deallocate(void *p, std::size_t bytes, std::size_t alignment,
+                      const mmap_options &options) noexcept;
+} // namespace detail
+
+template <class E> struct mmap_allocator {
+public:
+    using value_type                             = E;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    constexpr mmap_allocator(mmap_options options = mmap_options()) noexcept;
+    constexpr mmap_allocator(const mmap_allocator &) noexcept = default;
+
+    template <class U> constexpr mmap_allocator(const mmap_allocator<U> &other) noexcept;
+
+    constexpr mmap_allocator &operator=(const mmap_allocator &) = default;
+
+    constexpr ~mmap_allocator() = default;
+
+    static constexpr size_type max_size() noexcept;
+
+    [[nodiscard]] E *allocate(size_type n);
+    void             deallocate(E *p, size_type n) noexcept;
+
+    template <class U, class... Args>
+        requires std::convertible_to<U *, E *>
+    constexpr void construct(U *p, Args &&...args);
+
+    template <class U>
+        requires std::convertible_to<U *, E *>
+    constexpr void destroy(U *p);
+
+    [[nodiscard]] constexpr const mmap_options &options() const noexcept;
+
+    template <class U> struct rebind {
+        using other = mmap_allocator<U>;
+    };
+
+private:
+    mmap_options m_options;
+};
+
+template <class E, class U>
+constexpr bool operator==(const mmap_allocator<E> &lhs, const mmap_allocator<U> &rhs) noexcept;
+} // namespace ext
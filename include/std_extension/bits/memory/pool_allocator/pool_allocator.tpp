@@ -0,0 +1,69 @@
+#pragma once
+
+#include "std_extension/bits/memory/allocator/allocator.hpp"
+#include "synopsis.hpp"
+
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace ext {
+template <class E>
+template <class U>
+constexpr pool_allocator<E>::pool_allocator(const pool_allocator<U> &) noexcept {}
+
+template <class E> constexpr pool_allocator<E>::size_type pool_allocator<E>::max_size() noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(E);
+}
+
+template <class E> constexpr bool pool_allocator<E>::pooled(size_type n) noexcept {
+    return alignof(E) <= detail::POOL_GRANULE && n <= detail::POOL_MAX_SIZE / sizeof(E);
+}
+
+template <class E> [[nodiscard]] E *pool_allocator<E>::allocate(size_type n) {
+    static_assert(sizeof(E) > 0, "cannot allocate incomplete types");
+
+    if (n > max_size()) {
+        throw std::bad_array_new_length();
+    }
+
+    if (pooled(n)) {
+        return static_cast<E *>(detail::pool_allocate(n * sizeof(E)));
+    }
+
+    if constexpr (alignof(E) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<E *>(::operator new(n * sizeof(E), std::align_val_t(alignof(E))));
+    } else {
+        return static_cast<E *>(::operator new(n * sizeof(E)));
+    }
+}
+
+template <class E> void pool_allocator<E>::deallocate(E *p, size_type n) noexcept {
+    if (pooled(n)) {
+        detail::pool_deallocate(p, n * sizeof(E));
+    } else if constexpr (alignof(E) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, n * sizeof(E), std::align_val_t(alignof(E)));
+    } else {
+        ::operator delete(p, n * sizeof(E));
+    }
+}
+
+template <class E>
+template <class U, class... Args>
+    requires std::convertible_to<U *, E *>
+constexpr void pool_allocator<E>::construct(U *p, Args &&...args) {
+    ext::construct_at(p, std::forward<Args>(args)...);
+}
+
+template <class E>
+template <class U>
+    requires std::convertible_to<U *, E *>
+constexpr void pool_allocator<E>::destroy(U *p) {
+    ext::destroy_at(p);
+}
+
+template <class E, class U>
+constexpr bool operator==(const pool_allocator<E> &, const pool_allocator<U> &) noexcept {
+    return true;
+}
+} // namespace ext
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ext {
+namespace detail {
+inline constexpr std::size_t POOL_GRANULE  = 16;
+inline constexpr std::size_t POOL_MAX_SIZE = 1024;
+
+void *pool_allocate(std::size_t bytes);
+void  pool_deallocate(void *p, std::size_t bytes) noexcept;
+} // namespace detail
+
+template <class E> struct pool_allocator {
+public:
+    using value_type                             = E;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    constexpr pool_allocator() noexcept                       = default;
+    constexpr pool_allocator(const pool_allocator &) noexcept = default;
+
+    template <class U> constexpr pool_allocator(const pool_allocator<U> &) noexcept;
+
+    constexpr pool_allocator &operator=(const pool_allocator &) = default;
+
+    constexpr ~pool_allocator() = default;
+
+    static constexpr size_type max_size() noexcept;
+
+    [[nodiscard]] E *allocate(size_type n);
+    void             deallocate(E *p, size_type n) noexcept;
+
+    template <class U, class... Args>
+        requires std::convertible_to<U *, E *>
+    constexpr void construct(U *p, Args &&...args);
+
+    template <class U>
+        requires std::convertible_to<U *, E *>
+    constexpr void destroy(U *p);
+
+    template <class U> struct rebind {
+        using other = pool_allocator<U>;
+    };
+
+private:
+    static constexpr bool pooled(size_type n) noexcept;
+};
+
+template <class E, class U>
+constexpr bool operator==(const pool_allocator<E> &, const pool_allocator<U> &) noexcept;
+} // namespace ext
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "std_extension/bits/memory/allocator/synopsis.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ext {
+struct allocation_stats {
+    std::string_view type;
+    std::uint64_t    allocations   = 0;
+    std::uint64_t    deallocations = 0;
+    std::int64_t     live_bytes    = 0;
+    std::int64_t     peak_bytes    = 0;
+};
+
+std::vector<allocation_stats> allocation_snapshot();
+
+namespace detail {
+struct tracking_type;
+
+tracking_type &tracking_register(std::string_view name);
+void           tracking_allocated(tracking_type &type, std::size_t bytes) noexcept;
+void           tracking_deallocated(tracking_type &type, std::size_t bytes) noexcept;
+} // namespace detail
+
+template <class E, class Inner = allocator<E>> struct tracking_allocator {
+private:
+    using inner_traits = std::allocator_traits<Inner>;
+
+public:
+    using value_type      = E;
+    using size_type       = typename inner_traits::size_type;
+    using difference_type = typename inner_traits::difference_type;
+    using propagate_on_container_copy_assignment =
+        typename inner_traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment =
+        typename inner_traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+    using is_always_equal             = typename inner_traits::is_always_equal;
+
+    static_assert(std::is_same_v<typename inner_traits::value_type, E>,
+                  "inner allocator must allocate E");
+
+    constexpr tracking_allocator() noexcept(noexcept(Inner())) = default;
+    constexpr tracking_allocator(const Inner &inner) noexcept;
+    constexpr tracking_allocator(const tracking_allocator &) noexcept = default;
+
+    template <class U, class V>
+    constexpr tracking_allocator(const tracking_allocator<U, V> &other) noexcept;
+
+    constexpr tracking_allocator &operator=(const tracking_allocator &) = default;
+
+    constexpr ~tracking_allocator() = default;
+
+    constexpr size_type max_size() const noexcept;
+
+    [[nodiscard]] E *allocate(size_type n);
+    void             deallocate(E *p, size_type n) noexcept;
+
+    template <class U, class... Args>
+        requires std::convertible_to<U *, E *>
+    constexpr void construct(U *p, Args &&...args);
+
+    template <class U>
+        requires std::convertible_to<U *, E *>
+    constexpr void destroy(U *p);
+
+    constexpr tracking_allocator select_on_container_copy_construction() const;
+
+    [[nodiscard]] constexpr const Inner &inner() const noexcept;
+
+    template <class U> struct rebind {
+        using other = tracking_allocator<U, typename inner_traits::template rebind_alloc<U>>;
+    };
+
+private:
+    static detail::tracking_type &type();
+
+    [[no_unique_address]] Inner m_inner;
+};
+
+template <class E, class EInner, class U, class UInner>
+constexpr bool operator==(const tracking_allocator<E, EInner> &lhs,
+                          const tracking_allocator<U, UInner> &rhs) noexcept;
+} // namespace ext
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "std_extension/bits/memory/allocator/allocator.hpp"
+#include "std_extension/static_typeid.hpp"
+#include "synopsis.hpp"
+
+#include <utility>
+
+namespace ext {
+template <class E, class Inner>
+constexpr tracking_allocator<E, Inner>::tracking_allocator(const Inner &inner) noexcept
+    : m_inner(inner) {}
+
+template <class E, class Inner>
+template <class U, class V>
+constexpr tracking_allocator<E, Inner>::tracking_allocator(
+    const tracking_allocator<U, V> &other) noexcept
+    : m_inner(other.inner()) {}
+
+template <class E, class Inner>
+constexpr tracking_allocator<E, Inner>::size_type
+tracking_allocator<E, Inner>::max_size() const noexcept {
+    return inner_traits::max_size(m_inner);
+}
+
+template <class E, class Inner> detail::tracking_type &tracking_allocator<E, Inner>::type() {
+    static detail::tracking_type &type = detail::tracking_register(static_typeid<E>::name);
+    return type;
+}
+
+template <class E, class Inner>
+[[nodiscard]] E *tracking_allocator<E, Inner>::allocate(size_type n) {
+    detail::tracking_type &tracked = type();
+    E                     *p       = inner_traits::allocate(m_inner, n);
+    detail::tracking_allocated(tracked, n * sizeof(E));
+    return p;
+}
+
+template <class E, class Inner>
+void tracking_allocator<E, Inner>::deallocate(E *p, size_type n) noexcept {
+    inner_traits::deallocate(m_inner, p, n);
+    detail::tracking_deallocated(type(), n * sizeof(E));
+}
+
+template <class E, class Inner>
+template <class U, class... Args>
+    requires std::convertible_to<U *, E *>
+constexpr void tracking_allocator<E, Inner>::construct(U *p, Args &&...args) {
+    inner_traits::construct(m_inner, p, std::forward<Args>(args)...);
+}
+
+template <class E, class Inner>
+template <class U>
+    requires std::convertible_to<U *, E *>
+constexpr void tracking_allocator<E, Inner>::destroy(U *p) {
+    inner_traits::destroy(m_inner, p);
+}
+
+template <class E, class Inner>
+constexpr tracking_allocator<E, Inner>
+tracking_allocator<E, Inner>::select_on_container_copy_construction() const {
+    return tracking_allocator(inner_traits::select_on_container_copy_construction(m_inner));
+}
+
+template <class E, class Inner>
+constexpr const Inner &tracking_allocator<E, Inner>::inner() const noexcept {
+    return m_inner;
+}
+
+template <class E, class EInner, class U, class UInner>
+constexpr bool operator==(const tracking_allocator<E, EInner> &lhs,
+                          const tracking_allocator<U, UInner> &rhs) noexcept {
+    return lhs.inner() == rhs.inner();
+}
+} // namespace ext
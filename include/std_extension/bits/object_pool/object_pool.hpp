@@ -0,0 +1,3 @@
+#pragma once
+
+#include "object_pool.tpp"
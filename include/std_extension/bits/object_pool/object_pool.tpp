@@ -0,0 +1,169 @@
+#pragma once
+
+#include "std_extension/exception.hpp"
+#include "std_extension/memory.hpp"
+#include "synopsis.hpp"
+
+#include <bit>
+#include <new>
+#include <utility>
+
+namespace ext {
+template <class T> void object_pool<T>::recycler::operator()(T *p) const noexcept {
+    m_pool->recycle(p);
+}
+
+template <class T>
+object_pool<T>::object_pool(std::function<void(T &)> reset)
+    : m_reset(std::move(reset)) {}
+
+template <class T> object_pool<T>::~object_pool() {
+    while (Node *idle = pop(m_idle)) {
+        ext::destroy_at(object(*idle));
+    }
+
+    for (std::size_t chunk = 0; chunk < MAX_CHUNKS; ++chunk) {
+        Node *nodes = m_chunks[chunk].load(std::memory_order_relaxed);
+        if (nullptr != nodes) {
+            std::allocator<Node>().deallocate(nodes, std::size_t(BASE_CHUNK) << chunk);
+        }
+    }
+}
+
+template <class T>
+template <class... Args>
+    requires std::constructible_from<T, Args...>
+[[nodiscard]] std::shared_ptr<T> object_pool<T>::acquire(Args &&...args) {
+    // the control block comes from the pool allocator so a recycled acquire never hits malloc
+    return std::shared_ptr<T>(take(std::forward<Args>(args)...), recycler{this},
+                              pool_allocator<T>());
+}
+
+template <class T>
+template <class... Args>
+    requires std::constructible_from<T, Args...>
+[[nodiscard]] object_pool<T>::unique_ptr object_pool<T>::acquire_unique(Args &&...args) {
+    return unique_ptr(take(std::forward<Args>(args)...), recycler{this});
+}
+
+template <class T> std::size_t object_pool<T>::capacity() const noexcept {
+    return m_size.load(std::memory_order_relaxed);
+}
+
+template <class T> T *object_pool<T>::object(Node &node) noexcept {
+    return std::launder(reinterpret_cast<T *>(node.m_storage));
+}
+
+template <class T> object_pool<T>::Node &object_pool<T>::node(T *p) noexcept {
+    return *reinterpret_cast<Node *>(reinterpret_cast<std::byte *>(p));
+}
+
+namespace detail {
+// chunk c holds base << c nodes, starting at base * (2^c - 1)
+constexpr std::uint32_t object_pool_chunk(std::uint32_t index, std::uint32_t base) noexcept {
+    return std::bit_width(index / base + 1) - 1;
+}
+
+constexpr std::uint32_t object_pool_offset(std::uint32_t index, std::uint32_t base) noexcept {
+    return index - base * ((std::uint32_t(1) << object_pool_chunk(index, base)) - 1);
+}
+} // namespace detail
+
+template <class T> object_pool<T>::Node &object_pool<T>::at(std::uint32_t index) noexcept {
+    Node *nodes = m_chunks[detail::object_pool_chunk(index, BASE_CHUNK)].load(
+        std::memory_order_acquire);
+    return nodes[detail::object_pool_offset(index, BASE_CHUNK)];
+}
+
+template <class T> object_pool<T>::Node &object_pool<T>::grow(std::uint32_t index) {
+    std::uint32_t chunk = detail::object_pool_chunk(index, BASE_CHUNK);
+    if (chunk >= MAX_CHUNKS) {
+        throw exception("object_pool exhausted");
+    }
+
+    Node *nodes = m_chunks[chunk].load(std::memory_order_acquire);
+    if (nullptr == nodes) {
+        std::size_t count = std::size_t(BASE_CHUNK) << chunk;
+        Node       *fresh = std::allocator<Node>().allocate(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            ext::construct_at(fresh + i);
+        }
+
+        if (m_chunks[chunk].compare_exchange_strong(nodes, fresh, std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+            nodes = fresh;
+        } else {
+            std::allocator<Node>().deallocate(fresh, count);
+        }
+    }
+    return nodes[detail::object_pool_offset(index, BASE_CHUNK)];
+}
+
+template <class T>
+object_pool<T>::Node *object_pool<T>::pop(std::atomic_uint64_t &head) noexcept {
+    std::uint64_t current = head.load(std::memory_order_acquire);
+    while (0 != (current & INDEX_MASK)) {
+        Node         &top  = at(static_cast<std::uint32_t>(current & INDEX_MASK) - 1);
+        std::uint64_t next = ((current >> 32) + 1) << 32 |
+                             top.m_next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, next, std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+            return &top;
+        }
+    }
+    return nullptr;
+}
+
+template <class T>
+void object_pool<T>::push(std::atomic_uint64_t &head, Node &node) noexcept {
+    std::uint64_t current = head.load(std::memory_order_relaxed);
+    std::uint64_t next    = 0;
+    do {
+        node.m_next.store(static_cast<std::uint32_t>(current & INDEX_MASK),
+                          std::memory_order_relaxed);
+        next = ((current >> 32) + 1) << 32 | (std::uint64_t(node.m_index) + 1);
+    } while (!head.compare_exchange_weak(current, next, std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+template <class T> void object_pool<T>::recycle(T *p) noexcept {
+    Node &returned = node(p);
+    if (m_reset) {
+        try {
+            m_reset(*p);
+        } catch (...) {
+            // an object the hook cannot reset is not handed out again
+            ext::destroy_at(p);
+            push(m_raw, returned);
+            return;
+        }
+    }
+    push(m_idle, returned);
+}
+
+template <class T> object_pool<T>::Node &object_pool<T>::reserve() {
+    if (Node *raw = pop(m_raw)) {
+        return *raw;
+    }
+
+    std::uint32_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+    Node         &fresh = grow(index);
+    fresh.m_index       = index;
+    return fresh;
+}
+
+template <class T> template <class... Args> T *object_pool<T>::take(Args &&...args) {
+    if (Node *idle = pop(m_idle)) {
+        return object(*idle);
+    }
+
+    Node &fresh = reserve();
+    try {
+        return ext::construct_at(reinterpret_cast<T *>(fresh.m_storage),
+                                 std::forward<Args>(args)...);
+    } catch (...) {
+        push(m_raw, fresh);
+        throw;
+    }
+}
+} // namespace ext
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace ext {
+// The pool must outlive every handle it gave out.
+template <class T> class object_pool {
+public:
+    struct recycler {
+        void operator()(T *p) const noexcept;
+
+        object_pool *m_pool = nullptr;
+    };
+
+    using unique_ptr = std::unique_ptr<T, recycler>;
+
+    explicit object_pool(std::function<void(T &)> reset = nullptr);
+
+    object_pool(const object_pool &)            = delete;
+    object_pool &operator=(const object_pool &) = delete;
+
+    ~object_pool();
+
+    // args only construct a fresh object, a recycled one is handed out as the reset hook left it
+    template <class... Args>
+        requires std::constructible_from<T, Args...>
+    [[nodiscard]] std::shared_ptr<T> acquire(Args &&...args);
+
+    template <class... Args>
+        requires std::constructible_from<T, Args...>
+    [[nodiscard]] unique_ptr acquire_unique(Args &&...args);
+
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+private:
+    static constexpr std::uint32_t BASE_CHUNK = 64;
+    static constexpr std::size_t   MAX_CHUNKS = 26;
+    static constexpr std::uint64_t INDEX_MASK = 0xffffffff;
+
+    struct Node {
+        alignas(T) std::byte m_storage[sizeof(T)];
+        std::atomic_uint32_t m_next  = 0;
+        std::uint32_t        m_index = 0;
+    };
+
+    static T    *object(Node &node) noexcept;
+    static Node &node(T *p) noexcept;
+
+    Node &at(std::uint32_t index) noexcept;
+    Node &grow(std::uint32_t index);
+    Node *pop(std::atomic_uint64_t &head) noexcept;
+    void  push(std::atomic_uint64_t &head, Node &node) noexcept;
+    void  recycle(T *p) noexcept;
+    Node &reserve();
+
+    template <class... Args> T *take(Args &&...args);
+
+    std::function<void(T &)>                    m_reset;
+    std::array<std::atomic<Node *>, MAX_CHUNKS> m_chunks = {};
+    std::atomic_uint32_t                        m_size   = 0;
+    // tagged heads, tag in the high half and index + 1 in the low half
+    alignas(64) std::atomic_uint64_t m_idle = 0;
+    alignas(64) std::atomic_uint64_t m_raw  = 0;
+};
+} // namespace ext
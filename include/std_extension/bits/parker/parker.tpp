@@ -0,0 +1,23 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <type_traits>
+
+namespace ext {
+namespace detail {
+constexpr parker::parker() noexcept
+    : m_state(EMPTY) {}
+
+template <class Clock, class Duration>
+bool parker::park_until(const std::chrono::time_point<Clock, Duration> &abs_time) noexcept {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        return parkUntil(std::chrono::time_point_cast<std::chrono::steady_clock::duration>(abs_time));
+    } else {
+        return parkUntil(std::chrono::steady_clock::now() +
+                         std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time -
+                                                                                Clock::now()));
+    }
+}
+} // namespace detail
+} // namespace ext
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ext {
+namespace detail {
+class parker final {
+public:
+    constexpr parker() noexcept;
+
+    parker(const parker &)            = delete;
+    parker &operator=(const parker &) = delete;
+
+    ~parker() = default;
+
+    void park() noexcept;
+
+    template <class Clock, class Duration>
+    bool park_until(const std::chrono::time_point<Clock, Duration> &abs_time) noexcept;
+
+    void unpark() noexcept;
+
+private:
+    static constexpr std::uint32_t EMPTY    = 0;
+    static constexpr std::uint32_t NOTIFIED = 1;
+    static constexpr std::uint32_t PARKED   = ~std::uint32_t(0);
+
+    bool parkUntil(const std::chrono::steady_clock::time_point &abs_time) noexcept;
+
+    std::atomic_uint32_t m_state;
+};
+} // namespace detail
+} // namespace ext
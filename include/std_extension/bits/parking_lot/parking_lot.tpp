@@ -0,0 +1,32 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <utility>
+
+namespace ext {
+template <class Validate, class BeforeSleep>
+park_result parking_lot::park(const void *key, std::uintptr_t data, Validate validate,
+                              BeforeSleep before_sleep) {
+    return parkImpl(key, data, validate, before_sleep, nullptr);
+}
+
+template <class Validate, class BeforeSleep, class Clock, class Duration>
+park_result parking_lot::park_until(const void *key, std::uintptr_t data, Validate validate,
+                                    BeforeSleep                                     before_sleep,
+                                    const std::chrono::time_point<Clock, Duration> &abs_time) {
+    std::chrono::steady_clock::time_point steady_time;
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        steady_time = std::chrono::time_point_cast<std::chrono::steady_clock::duration>(abs_time);
+    } else {
+        steady_time = std::chrono::steady_clock::now() +
+                      std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time - Clock::now());
+    }
+    return parkImpl(key, data, validate, before_sleep, std::addressof(steady_time));
+}
+
+template <class Callback, class Finish>
+void parking_lot::unpark(const void *key, Callback callback, Finish finish) {
+    unparkImpl(key, callback, finish);
+}
+} // namespace ext
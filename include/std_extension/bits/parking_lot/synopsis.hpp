@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace ext {
+enum class park_result {
+    UNPARKED,
+    TIMEOUT,
+    SKIPPED,
+};
+
+enum class unpark_control {
+    RETAIN_CONTINUE,
+    REMOVE_CONTINUE,
+    RETAIN_BREAK,
+    REMOVE_BREAK,
+};
+
+class parking_lot final {
+public:
+    parking_lot() = delete;
+
+    template <class Validate, class BeforeSleep>
+    static park_result park(const void *key, std::uintptr_t data, Validate validate,
+                            BeforeSleep before_sleep);
+
+    template <class Validate, class BeforeSleep, class Clock, class Duration>
+    static park_result park_until(const void *key, std::uintptr_t data, Validate validate,
+                                  BeforeSleep                                     before_sleep,
+                                  const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Callback, class Finish>
+    static void unpark(const void *key, Callback callback, Finish finish);
+
+    static bool        unpark_one(const void *key);
+    static std::size_t unpark_all(const void *key);
+
+private:
+    template <class Signature> class FunctionRef;
+
+    template <class R, class... Args> class FunctionRef<R(Args...)> final {
+    public:
+        template <class F>
+            requires(!std::is_same_v<std::remove_cv_t<F>, FunctionRef>)
+        FunctionRef(F &f) noexcept
+            : m_obj(std::addressof(f))
+            , m_call([](void *obj, Args... args) -> R {
+                return (*static_cast<F *>(obj))(std::forward<Args>(args)...);
+            }) {}
+
+        R operator()(Args... args) const { return m_call(m_obj, std::forward<Args>(args)...); }
+
+    private:
+        void *m_obj;
+        R (*m_call)(void *, Args...);
+    };
+
+    static park_result parkImpl(const void *key, std::uintptr_t data,
+                                FunctionRef<bool()> validate, FunctionRef<void()> before_sleep,
+                                const std::chrono::steady_clock::time_point *abs_time);
+
+    static void unparkImpl(const void *key, FunctionRef<unpark_control(std::uintptr_t)> callback,
+                           FunctionRef<void(bool)> finish);
+};
+} // namespace ext
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <memory>
+#include <type_traits>
+
+namespace ext {
+template <class Clock, class Duration>
+bool phaser::await_advance_until(std::uint32_t                                   phase,
+                                 const std::chrono::time_point<Clock, Duration> &abs_time) const {
+    std::chrono::steady_clock::time_point steady_time;
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        steady_time = std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time);
+    } else {
+        auto rel_time =
+            std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time - Clock::now());
+        steady_time = std::chrono::steady_clock::now() + rel_time;
+    }
+    return awaitUntil(phase, std::addressof(steady_time));
+}
+
+template <class Rep, class Period>
+bool phaser::await_advance_for(std::uint32_t                             phase,
+                               const std::chrono::duration<Rep, Period> &rel_time) const {
+    return await_advance_until(phase, std::chrono::steady_clock::now() + rel_time);
+}
+} // namespace ext
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ext {
+class phaser final {
+public:
+    explicit phaser(std::size_t parties = 0);
+
+    phaser(const phaser &)            = delete;
+    phaser &operator=(const phaser &) = delete;
+
+    ~phaser() = default;
+
+    std::uint32_t register_party();
+    std::uint32_t bulk_register(std::size_t parties);
+
+    std::uint32_t arrive();
+    std::uint32_t arrive_and_deregister();
+    std::uint32_t arrive_and_await_advance();
+
+    std::uint32_t await_advance(std::uint32_t phase) const;
+
+    template <class Clock, class Duration>
+    bool await_advance_until(std::uint32_t                                   phase,
+                             const std::chrono::time_point<Clock, Duration> &abs_time) const;
+
+    template <class Rep, class Period>
+    bool await_advance_for(std::uint32_t                             phase,
+                           const std::chrono::duration<Rep, Period> &rel_time) const;
+
+    [[nodiscard]] std::uint32_t phase() const noexcept;
+    [[nodiscard]] std::size_t   registered_parties() const noexcept;
+    [[nodiscard]] std::size_t   arrived_parties() const noexcept;
+    [[nodiscard]] std::size_t   unarrived_parties() const noexcept;
+
+private:
+    static constexpr std::uint64_t PARTIES_SHIFT = 16;
+    static constexpr std::uint64_t PHASE_SHIFT   = 32;
+    static constexpr std::uint64_t MAX_PARTIES   = 0xffff;
+
+    static constexpr std::uint32_t phaseOf(std::uint64_t state) noexcept;
+    static constexpr std::uint64_t partiesOf(std::uint64_t state) noexcept;
+    static constexpr std::uint64_t unarrivedOf(std::uint64_t state) noexcept;
+
+    std::uint32_t arriveImpl(std::uint64_t deregister);
+    bool          awaitUntil(std::uint32_t                                phase,
+                             const std::chrono::steady_clock::time_point *abs_time) const;
+
+    std::atomic_uint64_t m_state;
+};
+} // namespace ext
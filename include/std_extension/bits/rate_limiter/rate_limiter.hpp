@@ -0,0 +1,3 @@
+#pragma once
+
+#include "rate_limiter.tpp"
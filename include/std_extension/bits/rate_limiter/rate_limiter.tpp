@@ -0,0 +1,34 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <type_traits>
+
+namespace ext {
+template <class Clock, class Duration>
+bool rate_limiter::try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+    return try_acquire_until(1, abs_time);
+}
+
+template <class Clock, class Duration>
+bool rate_limiter::try_acquire_until(std::size_t                                     count,
+                                     const std::chrono::time_point<Clock, Duration> &abs_time) {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        return waitUntil(count, std::chrono::ceil<std::chrono::nanoseconds>(abs_time));
+    } else {
+        auto rel_time = std::chrono::ceil<std::chrono::nanoseconds>(abs_time - Clock::now());
+        return waitUntil(count, std::chrono::steady_clock::now() + rel_time);
+    }
+}
+
+template <class Rep, class Period>
+bool rate_limiter::try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_acquire_until(1, std::chrono::steady_clock::now() + rel_time);
+}
+
+template <class Rep, class Period>
+bool rate_limiter::try_acquire_for(std::size_t                               count,
+                                   const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_acquire_until(count, std::chrono::steady_clock::now() + rel_time);
+}
+} // namespace ext
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ext {
+class rate_limiter final {
+public:
+    rate_limiter(double rate, std::size_t burst);
+
+    rate_limiter(const rate_limiter &)            = delete;
+    rate_limiter &operator=(const rate_limiter &) = delete;
+
+    ~rate_limiter() = default;
+
+    void acquire(std::size_t count = 1);
+    bool try_acquire(std::size_t count = 1) noexcept;
+
+    template <class Clock, class Duration>
+    bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Clock, class Duration>
+    bool try_acquire_until(std::size_t                                     count,
+                           const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Rep, class Period>
+    bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time);
+
+    template <class Rep, class Period>
+    bool try_acquire_for(std::size_t count, const std::chrono::duration<Rep, Period> &rel_time);
+
+    [[nodiscard]] double      rate() const noexcept;
+    [[nodiscard]] std::size_t burst() const noexcept;
+
+private:
+    using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::nanoseconds>;
+
+    static std::chrono::nanoseconds intervalOf(double rate, std::size_t burst);
+
+    bool reserve(std::size_t count, TimePoint deadline, TimePoint &ready) noexcept;
+    bool waitUntil(std::size_t count, TimePoint deadline);
+
+    const std::chrono::nanoseconds m_interval;
+    const std::size_t              m_burst;
+    std::atomic_int64_t            m_tat;
+};
+} // namespace ext
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "std_extension/deferred_task.hpp"
 #include "std_extension/exception.hpp"
+#include "std_extension/parking_lot.hpp"
 #include "std_extension/unexpected_deferred_task.hpp"
 #include "synopsis.hpp"
 
@@ -13,11 +13,27 @@ constexpr std::size_t counting_semaphore<LeastMaxValue>::max() noexcept {
     return std::numeric_limits<std::size_t>::max();
 }
 
+template <std::size_t LeastMaxValue>
+constexpr std::size_t counting_semaphore<LeastMaxValue>::value(std::size_t state) noexcept {
+    return state / ONE;
+}
+
+template <std::size_t LeastMaxValue>
+constexpr std::size_t counting_semaphore<LeastMaxValue>::add(std::size_t state,
+                                                             std::size_t update) noexcept {
+    return state + std::min(MAX_VALUE - value(state), update) * ONE;
+}
+
+template <std::size_t LeastMaxValue>
+void counting_semaphore<LeastMaxValue>::checkCount(std::size_t count) {
+    if (count > MAX_VALUE) {
+        throw exception("counting_semaphore count exceeds max value");
+    }
+}
+
 template <std::size_t LeastMaxValue>
 counting_semaphore<LeastMaxValue>::counting_semaphore(std::size_t desired) noexcept
-    : m_value(std::min(LeastMaxValue, desired))
-    , m_waiting(0)
-    , m_notified(0) {}
+    : m_state(std::min(MAX_VALUE, desired) * ONE) {}
 
 template <std::size_t LeastMaxValue>
 void counting_semaphore<LeastMaxValue>::release(std::size_t update) {
@@ -25,55 +41,34 @@ void counting_semaphore<LeastMaxValue>::release(std::size_t update) {
         return;
     }
 
-    std::size_t minUpdate = 0;
-    {
-        std::lock_guard guard(m_mutex);
-        minUpdate = std::min(m_waiting, update);
-        if (max() - minUpdate < m_notified) {
-            throw exception("m_notified overflow");
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (0 == (state & WAITERS)) {
+        if (m_state.compare_exchange_weak(state, add(state, update), std::memory_order_release)) {
+            return;
         }
-        m_waiting -= minUpdate;
-        m_notified += minUpdate;
-        m_value += std::min(LeastMaxValue - m_value, update - minUpdate);
-    }
-    if (0 != minUpdate) {
-        m_cv.notify_one();
     }
+    releaseNext(update);
 }
 
-template <std::size_t LeastMaxValue> void counting_semaphore<LeastMaxValue>::acquire() {
-    std::size_t   remainingNotifications = 0;
-    deferred_task defer([this, &remainingNotifications] {
-        if (0 != remainingNotifications) {
-            m_cv.notify_one();
-        }
-    });
-
-    unexpected_deferred_task unexpectedDefer([this] { m_cv.notify_one(); });
-
-    std::unique_lock lock(m_mutex);
-    if (0 != m_value) {
-        --m_value;
+template <std::size_t LeastMaxValue>
+void counting_semaphore<LeastMaxValue>::acquire(std::size_t count) {
+    checkCount(count);
+    if (try_acquire(count)) {
         return;
     }
 
-    if (max() == m_waiting) {
-        throw exception("m_waiting overflow");
-    }
-
-    unexpected_deferred_task unexpectedDefer2([this] { --m_waiting; });
-
-    ++m_waiting;
-    m_cv.wait(lock, [this] { return 0 != m_notified; });
-    remainingNotifications = --m_notified;
+    unexpected_deferred_task unexpected([this] { releaseNext(0); });
+    parking_lot::park(this, count, [this, count] { return validate(count); }, [] {});
 }
 
 template <std::size_t LeastMaxValue>
-bool counting_semaphore<LeastMaxValue>::try_acquire() noexcept {
-    std::lock_guard guard(m_mutex);
-    if (0 != m_value) {
-        --m_value;
-        return true;
+bool counting_semaphore<LeastMaxValue>::try_acquire(std::size_t count) noexcept {
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (value(state) >= count) {
+        if (m_state.compare_exchange_weak(state, state - count * ONE,
+                                          std::memory_order_acquire)) {
+            return true;
+        }
     }
     return false;
 }
@@ -82,43 +77,82 @@ template <std::size_t LeastMaxValue>
 template <class Clock, class Duration>
 bool counting_semaphore<LeastMaxValue>::try_acquire_until(
     const std::chrono::time_point<Clock, Duration> &abs_time) {
-    std::size_t remainingNotifications = 0;
-
-    deferred_task defer([this, &remainingNotifications] {
-        if (0 != remainingNotifications) {
-            m_cv.notify_one();
-        }
-    });
-
-    unexpected_deferred_task unexpectedDefer([this] { m_cv.notify_one(); });
-
-    bool             res = true;
-    std::unique_lock lock(m_mutex);
-    if (0 != m_value) {
-        --m_value;
-        return res;
-    }
+    return try_acquire_until(1, abs_time);
+}
 
-    if (max() == m_waiting) {
-        throw exception("m_waiting overflow");
+template <std::size_t LeastMaxValue>
+template <class Clock, class Duration>
+bool counting_semaphore<LeastMaxValue>::try_acquire_until(
+    std::size_t count, const std::chrono::time_point<Clock, Duration> &abs_time) {
+    checkCount(count);
+    if (try_acquire(count)) {
+        return true;
     }
 
-    unexpected_deferred_task unexpectedDefer2([this] { --m_waiting; });
-
-    ++m_waiting;
-    res = m_cv.wait_until(lock, abs_time, [this] { return 0 != m_notified; });
-    if (res) {
-        remainingNotifications = --m_notified;
-    } else {
-        --m_waiting;
+    unexpected_deferred_task unexpected([this] { releaseNext(0); });
+    park_result              res = parking_lot::park_until(
+        this, count, [this, count] { return validate(count); }, [] {}, abs_time);
+    if (park_result::TIMEOUT == res) {
+        releaseNext(0);
+        return false;
     }
-    return res;
+    return true;
 }
 
 template <std::size_t LeastMaxValue>
 template <class Rep, class Period>
 bool counting_semaphore<LeastMaxValue>::try_acquire_for(
     const std::chrono::duration<Rep, Period> &rel_time) {
-    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+    return try_acquire_until(1, std::chrono::steady_clock::now() + rel_time);
+}
+
+template <std::size_t LeastMaxValue>
+template <class Rep, class Period>
+bool counting_semaphore<LeastMaxValue>::try_acquire_for(
+    std::size_t count, const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_acquire_until(count, std::chrono::steady_clock::now() + rel_time);
+}
+
+template <std::size_t LeastMaxValue>
+bool counting_semaphore<LeastMaxValue>::validate(std::size_t count) noexcept {
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    for (;;) {
+        if (value(state) >= count) {
+            if (m_state.compare_exchange_weak(state, state - count * ONE,
+                                              std::memory_order_acquire)) {
+                return false;
+            }
+        } else if (0 != (state & WAITERS) ||
+                   m_state.compare_exchange_weak(state, state | WAITERS,
+                                                 std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+template <std::size_t LeastMaxValue>
+void counting_semaphore<LeastMaxValue>::releaseNext(std::size_t update) {
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (!m_state.compare_exchange_weak(state, add(state, update), std::memory_order_release)) {}
+
+    parking_lot::unpark(
+        this,
+        [this](std::uintptr_t count) {
+            std::size_t state = m_state.load(std::memory_order_relaxed);
+            do {
+                if (value(state) < count) {
+                    return unpark_control::RETAIN_CONTINUE;
+                }
+            } while (!m_state.compare_exchange_weak(state, state - count * ONE,
+                                                    std::memory_order_acquire));
+            return unpark_control::REMOVE_CONTINUE;
+        },
+        [this](bool has_more) {
+            if (has_more) {
+                m_state.fetch_or(WAITERS, std::memory_order_relaxed);
+            } else {
+                m_state.fetch_and(~WAITERS, std::memory_order_relaxed);
+            }
+        });
 }
 } // namespace ext
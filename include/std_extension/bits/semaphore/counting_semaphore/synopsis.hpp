@@ -1,11 +1,10 @@
 #pragma once
 
-#include "std_extension/condition_variable.hpp"
-
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <limits>
-#include <mutex>
 
 namespace ext {
 template <std::size_t LeastMaxValue = std::numeric_limits<std::size_t>::max()>
@@ -23,21 +22,37 @@ public:
     counting_semaphore &operator=(const counting_semaphore &) = delete;
 
     void release(std::size_t update = 1);
-    void acquire();
-    bool try_acquire() noexcept;
+    void acquire(std::size_t count = 1);
+    bool try_acquire(std::size_t count = 1) noexcept;
 
     template <class Clock, class Duration>
     bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time);
 
+    template <class Clock, class Duration>
+    bool try_acquire_until(std::size_t                                     count,
+                           const std::chrono::time_point<Clock, Duration> &abs_time);
+
     template <class Rep, class Period>
     bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time);
 
+    template <class Rep, class Period>
+    bool try_acquire_for(std::size_t count, const std::chrono::duration<Rep, Period> &rel_time);
+
 private:
-    std::size_t        m_value;
-    std::size_t        m_waiting;
-    std::size_t        m_notified;
-    std::mutex         m_mutex;
-    condition_variable m_cv;
+    static constexpr std::size_t WAITERS   = 1;
+    static constexpr std::size_t ONE       = 2;
+    static constexpr std::size_t MAX_VALUE =
+        std::min(LeastMaxValue, std::numeric_limits<std::size_t>::max() / ONE);
+
+    static constexpr std::size_t value(std::size_t state) noexcept;
+    static constexpr std::size_t add(std::size_t state, std::size_t update) noexcept;
+
+    static void checkCount(std::size_t count);
+
+    bool validate(std::size_t count) noexcept;
+    void releaseNext(std::size_t update);
+
+    std::atomic_size_t m_state;
 };
 
 using binary_semaphore = counting_semaphore<1>;
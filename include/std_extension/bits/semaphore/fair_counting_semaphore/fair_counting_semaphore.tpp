@@ -1,7 +1,8 @@
 #pragma once
 
-#include "std_extension/deferred_task.hpp"
 #include "std_extension/exception.hpp"
+#include "std_extension/parking_lot.hpp"
+#include "std_extension/unexpected_deferred_task.hpp"
 #include "synopsis.hpp"
 
 #include <algorithm>
@@ -9,57 +10,33 @@
 
 namespace ext {
 template <std::size_t LeastMaxValue>
-fair_counting_semaphore<LeastMaxValue>::UnsafeBinarySemaphore::UnsafeBinarySemaphore()
-    : m_isReleased(false) {}
-
-template <std::size_t LeastMaxValue>
-void fair_counting_semaphore<LeastMaxValue>::UnsafeBinarySemaphore::release() noexcept {
-    {
-        std::lock_guard guard(m_mutex);
-        m_isReleased = true;
-    }
-    m_cv.notify_one();
+constexpr std::size_t fair_counting_semaphore<LeastMaxValue>::max() noexcept {
+    return std::numeric_limits<std::size_t>::max();
 }
 
 template <std::size_t LeastMaxValue>
-void fair_counting_semaphore<LeastMaxValue>::UnsafeBinarySemaphore::acquire() {
-    std::unique_lock lock(m_mutex);
-    m_cv.wait(lock, [this] { return m_isReleased; });
+constexpr std::size_t fair_counting_semaphore<LeastMaxValue>::value(std::size_t state) noexcept {
+    return state / ONE;
 }
 
 template <std::size_t LeastMaxValue>
-template <class Clock, class Duration>
-bool fair_counting_semaphore<LeastMaxValue>::UnsafeBinarySemaphore::try_acquire_until(
-    const std::chrono::time_point<Clock, Duration> &abs_time) {
-    std::unique_lock lock(m_mutex);
-    return m_cv.wait_until(lock, abs_time, [this] { return m_isReleased; });
+constexpr std::size_t fair_counting_semaphore<LeastMaxValue>::add(std::size_t state,
+                                                                  std::size_t update) noexcept {
+    return state + std::min(MAX_VALUE - value(state), update) * ONE;
 }
 
 template <std::size_t LeastMaxValue>
-template <class Rep, class Period>
-bool fair_counting_semaphore<LeastMaxValue>::UnsafeBinarySemaphore::try_acquire_for(
-    const std::chrono::duration<Rep, Period> &rel_time) {
-    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
-}
-
-template <std::size_t LeastMaxValue>
-fair_counting_semaphore<LeastMaxValue>::ThreadBlocker::ThreadBlocker()
-    : m_released(false)
-    , m_next(nullptr)
-    , m_prev(nullptr) {}
-
-template <std::size_t LeastMaxValue>
-constexpr std::size_t fair_counting_semaphore<LeastMaxValue>::max() noexcept {
-    return std::numeric_limits<std::size_t>::max();
+void fair_counting_semaphore<LeastMaxValue>::checkCount(std::size_t count) {
+    if (count > MAX_VALUE) {
+        throw exception("fair_counting_semaphore count exceeds max value");
+    }
 }
 
 template <std::size_t LeastMaxValue>
-fair_counting_semaphore<LeastMaxValue>::fair_counting_semaphore(std::size_t desired) noexcept
-    : m_value(std::min(LeastMaxValue, desired))
-    , m_waiting(0)
-    , m_notified(0)
-    , m_head(nullptr)
-    , m_tail(nullptr) {}
+fair_counting_semaphore<LeastMaxValue>::fair_counting_semaphore(std::size_t    desired,
+                                                                barging_policy policy) noexcept
+    : m_policy(policy)
+    , m_state(std::min(MAX_VALUE, desired) * ONE) {}
 
 template <std::size_t LeastMaxValue>
 void fair_counting_semaphore<LeastMaxValue>::release(std::size_t update) {
@@ -67,52 +44,32 @@ void fair_counting_semaphore<LeastMaxValue>::release(std::size_t update) {
         return;
     }
 
-    ThreadBlocker *next = nullptr;
-    {
-        std::lock_guard guard(m_mutex);
-        std::size_t     minUpdate = std::min(m_waiting, update);
-        if (max() - minUpdate < m_notified) {
-            throw exception("m_notified overflow");
-        }
-        m_waiting -= minUpdate;
-        m_notified += minUpdate;
-        m_value += std::min(LeastMaxValue - m_value, update - minUpdate);
-        if (0 != minUpdate && minUpdate == m_notified) {
-            next = dequeue();
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (0 == (state & WAITERS)) {
+        if (m_state.compare_exchange_weak(state, add(state, update), std::memory_order_release)) {
+            return;
         }
     }
-
-    if (nullptr != next) {
-        next->m_sem.release();
-    }
+    releaseNext(update);
 }
 
-template <std::size_t LeastMaxValue> void fair_counting_semaphore<LeastMaxValue>::acquire() {
-    ThreadBlocker threadBlocker;
-    {
-        std::lock_guard guard(m_mutex);
-        if (0 != m_value) {
-            --m_value;
-            return;
-        }
-
-        if (max() == m_waiting) {
-            throw exception("m_waiting overflow");
-        }
-
-        ++m_waiting;
-        enqueue(std::addressof(threadBlocker));
+template <std::size_t LeastMaxValue>
+void fair_counting_semaphore<LeastMaxValue>::acquire(std::size_t count) {
+    checkCount(count);
+    if (!try_acquire(count)) {
+        acquireSlow<std::chrono::steady_clock, std::chrono::steady_clock::duration>(count,
+                                                                                    nullptr);
     }
-    deferred_task defer([this, &threadBlocker] { releaseNext(threadBlocker); });
-    threadBlocker.m_sem.acquire();
 }
 
 template <std::size_t LeastMaxValue>
-bool fair_counting_semaphore<LeastMaxValue>::try_acquire() noexcept {
-    std::lock_guard guard(m_mutex);
-    if (m_value > 0) {
-        --m_value;
-        return true;
+bool fair_counting_semaphore<LeastMaxValue>::try_acquire(std::size_t count) noexcept {
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (0 == (state & HANDOFF) && value(state) >= count) {
+        if (m_state.compare_exchange_weak(state, state - count * ONE,
+                                          std::memory_order_acquire)) {
+            return true;
+        }
     }
     return false;
 }
@@ -121,92 +78,145 @@ template <std::size_t LeastMaxValue>
 template <class Clock, class Duration>
 bool fair_counting_semaphore<LeastMaxValue>::try_acquire_until(
     const std::chrono::time_point<Clock, Duration> &abs_time) {
-    ThreadBlocker threadBlocker;
-    {
-        std::lock_guard guard(m_mutex);
-        if (0 != m_value) {
-            --m_value;
-            return true;
-        }
-
-        if (max() == m_waiting) {
-            throw exception("m_waiting overflow");
-        }
+    return try_acquire_until(1, abs_time);
+}
 
-        ++m_waiting;
-        enqueue(std::addressof(threadBlocker));
-    }
-    {
-        deferred_task defer([this, &threadBlocker] { releaseNext(threadBlocker); });
-        threadBlocker.m_sem.try_acquire_until(abs_time);
-    }
-    return threadBlocker.m_released;
+template <std::size_t LeastMaxValue>
+template <class Clock, class Duration>
+bool fair_counting_semaphore<LeastMaxValue>::try_acquire_until(
+    std::size_t count, const std::chrono::time_point<Clock, Duration> &abs_time) {
+    checkCount(count);
+    return try_acquire(count) || acquireSlow(count, std::addressof(abs_time));
 }
 
 template <std::size_t LeastMaxValue>
 template <class Rep, class Period>
 bool fair_counting_semaphore<LeastMaxValue>::try_acquire_for(
     const std::chrono::duration<Rep, Period> &rel_time) {
-    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+    return try_acquire_until(1, std::chrono::steady_clock::now() + rel_time);
 }
 
 template <std::size_t LeastMaxValue>
-void fair_counting_semaphore<LeastMaxValue>::releaseNext(ThreadBlocker &threadBlocker) {
-    ThreadBlocker *next = nullptr;
-    {
-        std::lock_guard guard(m_mutex);
-        if (threadBlocker.m_released) {
-            if (0 != --m_notified) {
-                next = dequeue();
-            }
-        } else {
-            remove(std::addressof(threadBlocker));
-            --m_waiting;
-        }
-    }
+template <class Rep, class Period>
+bool fair_counting_semaphore<LeastMaxValue>::try_acquire_for(
+    std::size_t count, const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_acquire_until(count, std::chrono::steady_clock::now() + rel_time);
+}
 
-    if (nullptr != next) {
-        next->m_sem.release();
-    }
+template <std::size_t LeastMaxValue>
+bool fair_counting_semaphore<LeastMaxValue>::strict() const noexcept {
+    return 0 == m_policy.max_bypasses && 0 == m_policy.max_wait.count();
 }
 
 template <std::size_t LeastMaxValue>
-void fair_counting_semaphore<LeastMaxValue>::enqueue(ThreadBlocker *threadBlocker) noexcept {
-    if (nullptr == m_tail) {
-        m_head = m_tail = threadBlocker;
-    } else {
-        threadBlocker->m_prev = m_tail;
-        m_tail->m_next        = threadBlocker;
-        m_tail                = threadBlocker;
-    }
+bool fair_counting_semaphore<LeastMaxValue>::isDue(
+    const Waiter &waiter, std::chrono::steady_clock::time_point now) const noexcept {
+    return strict() || (0 != m_policy.max_bypasses && waiter.m_bypasses >= m_policy.max_bypasses) ||
+           (0 != m_policy.max_wait.count() && now - waiter.m_since >= m_policy.max_wait);
 }
 
 template <std::size_t LeastMaxValue>
-fair_counting_semaphore<LeastMaxValue>::ThreadBlocker *
-fair_counting_semaphore<LeastMaxValue>::dequeue() noexcept {
-    ThreadBlocker *released = m_head;
-    released->m_released    = true;
-    m_head                  = released->m_next;
-    if (nullptr == m_head) {
-        m_tail = nullptr;
-    } else {
-        m_head->m_prev = nullptr;
+bool fair_counting_semaphore<LeastMaxValue>::validate(std::size_t count) noexcept {
+    std::size_t waiting = strict() ? WAITERS | HANDOFF : WAITERS;
+    std::size_t state   = m_state.load(std::memory_order_relaxed);
+    for (;;) {
+        if (0 == (state & HANDOFF) && value(state) >= count) {
+            if (m_state.compare_exchange_weak(state, state - count * ONE,
+                                              std::memory_order_acquire)) {
+                return false;
+            }
+        } else if (waiting == (state & waiting) ||
+                   m_state.compare_exchange_weak(state, state | waiting,
+                                                 std::memory_order_relaxed)) {
+            return true;
+        }
     }
-    return released;
 }
 
 template <std::size_t LeastMaxValue>
-void fair_counting_semaphore<LeastMaxValue>::remove(ThreadBlocker *threadBlocker) noexcept {
-    if (nullptr != threadBlocker->m_prev) {
-        threadBlocker->m_prev->m_next = threadBlocker->m_next;
-    } else {
-        m_head = threadBlocker->m_next;
+template <class Clock, class Duration>
+bool fair_counting_semaphore<LeastMaxValue>::acquireSlow(
+    std::size_t count, const std::chrono::time_point<Clock, Duration> *abs_time) {
+    Waiter waiter{count, 0, std::chrono::steady_clock::time_point(), false};
+    if (0 != m_policy.max_wait.count()) {
+        waiter.m_since = std::chrono::steady_clock::now();
+    }
+
+    auto data     = reinterpret_cast<std::uintptr_t>(std::addressof(waiter));
+    auto validate = [this, count] { return this->validate(count); };
+
+    unexpected_deferred_task unexpected([this] { releaseNext(0); });
+    for (;;) {
+        park_result res = nullptr == abs_time
+                              ? parking_lot::park(this, data, validate, [] {})
+                              : parking_lot::park_until(this, data, validate, [] {}, *abs_time);
+        if (park_result::TIMEOUT == res) {
+            releaseNext(0);
+            return false;
+        }
+
+        if (park_result::SKIPPED == res || waiter.m_granted) {
+            return true;
+        }
+
+        // woken to compete and lost the permits to a barging thread
+        ++waiter.m_bypasses;
     }
+}
+
+template <std::size_t LeastMaxValue>
+void fair_counting_semaphore<LeastMaxValue>::releaseNext(std::size_t update) {
+    std::size_t state = m_state.load(std::memory_order_relaxed);
+    while (!m_state.compare_exchange_weak(state, add(state, update), std::memory_order_release)) {}
 
-    if (nullptr != threadBlocker->m_next) {
-        threadBlocker->m_next->m_prev = threadBlocker->m_prev;
-    } else {
-        m_tail = threadBlocker->m_prev;
+    std::chrono::steady_clock::time_point now;
+    if (0 != m_policy.max_wait.count()) {
+        now = std::chrono::steady_clock::now();
     }
+
+    std::size_t promised = 0;
+    bool        reserved = false;
+    parking_lot::unpark(
+        this,
+        [this, now, &promised, &reserved](std::uintptr_t data) {
+            Waiter     &waiter = *reinterpret_cast<Waiter *>(data);
+            std::size_t state  = m_state.load(std::memory_order_relaxed);
+            if (!isDue(waiter, now)) {
+                if (value(state) >= promised + waiter.m_count) {
+                    promised += waiter.m_count;
+                    return unpark_control::REMOVE_CONTINUE;
+                }
+                // permits that don't fit pass this waiter by for a barging thread to take
+                if (value(state) > promised) {
+                    ++waiter.m_bypasses;
+                }
+                if (!isDue(waiter, now)) {
+                    return unpark_control::RETAIN_CONTINUE;
+                }
+            }
+
+            do {
+                if (value(state) < waiter.m_count) {
+                    reserved = true;
+                    return unpark_control::RETAIN_BREAK;
+                }
+            } while (!m_state.compare_exchange_weak(state, state - waiter.m_count * ONE,
+                                                    std::memory_order_acquire));
+            waiter.m_granted = true;
+            return unpark_control::REMOVE_CONTINUE;
+        },
+        [this, &reserved](bool has_more) {
+            std::size_t state = m_state.load(std::memory_order_relaxed);
+            std::size_t desired;
+            do {
+                desired = state & ~(WAITERS | HANDOFF);
+                if (has_more) {
+                    desired |= WAITERS;
+                }
+                if (reserved) {
+                    desired |= HANDOFF;
+                }
+            } while (!m_state.compare_exchange_weak(state, desired, std::memory_order_relaxed));
+        });
 }
 } // namespace ext
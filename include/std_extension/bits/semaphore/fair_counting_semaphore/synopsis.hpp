@@ -1,13 +1,17 @@
 #pragma once
 
-#include "std_extension/condition_variable.hpp"
-
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <limits>
-#include <mutex>
 
 namespace ext {
+struct barging_policy {
+    std::size_t               max_bypasses = 0;
+    std::chrono::microseconds max_wait     = std::chrono::microseconds::zero();
+};
+
 template <std::size_t LeastMaxValue = std::numeric_limits<std::size_t>::max()>
 class fair_counting_semaphore {
     static_assert(LeastMaxValue > 0, "LeastMaxValue must be positive");
@@ -15,7 +19,8 @@ class fair_counting_semaphore {
 public:
     static constexpr std::size_t max() noexcept;
 
-    explicit fair_counting_semaphore(std::size_t desired) noexcept;
+    explicit fair_counting_semaphore(std::size_t    desired,
+                                     barging_policy policy = barging_policy()) noexcept;
 
     fair_counting_semaphore(const fair_counting_semaphore &)            = delete;
     fair_counting_semaphore &operator=(const fair_counting_semaphore &) = delete;
@@ -23,61 +28,51 @@ public:
     ~fair_counting_semaphore() = default;
 
     void release(std::size_t update = 1);
-    void acquire();
-    bool try_acquire() noexcept;
+    void acquire(std::size_t count = 1);
+    bool try_acquire(std::size_t count = 1) noexcept;
 
     template <class Clock, class Duration>
     bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time);
 
+    template <class Clock, class Duration>
+    bool try_acquire_until(std::size_t                                     count,
+                           const std::chrono::time_point<Clock, Duration> &abs_time);
+
     template <class Rep, class Period>
     bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time);
 
-private:
-    class UnsafeBinarySemaphore {
-    public:
-        UnsafeBinarySemaphore();
-
-        UnsafeBinarySemaphore(const UnsafeBinarySemaphore &)            = delete;
-        UnsafeBinarySemaphore &operator=(const UnsafeBinarySemaphore &) = delete;
-
-        ~UnsafeBinarySemaphore() = default;
-
-        void release() noexcept;
-        void acquire();
-
-        template <class Clock, class Duration>
-        bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time);
-
-        template <class Rep, class Period>
-        bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time);
+    template <class Rep, class Period>
+    bool try_acquire_for(std::size_t count, const std::chrono::duration<Rep, Period> &rel_time);
 
-    private:
-        bool               m_isReleased;
-        std::mutex         m_mutex;
-        condition_variable m_cv;
+private:
+    static constexpr std::size_t WAITERS   = 1;
+    static constexpr std::size_t HANDOFF   = 2;
+    static constexpr std::size_t ONE       = 4;
+    static constexpr std::size_t MAX_VALUE =
+        std::min(LeastMaxValue, std::numeric_limits<std::size_t>::max() / ONE);
+
+    static constexpr std::size_t value(std::size_t state) noexcept;
+    static constexpr std::size_t add(std::size_t state, std::size_t update) noexcept;
+
+    struct Waiter {
+        std::size_t                           m_count;
+        std::size_t                           m_bypasses;
+        std::chrono::steady_clock::time_point m_since;
+        bool                                  m_granted;
     };
 
-    struct ThreadBlocker {
-        ThreadBlocker();
-        ~ThreadBlocker() = default;
-        bool                  m_released;
-        ThreadBlocker        *m_next;
-        ThreadBlocker        *m_prev;
-        UnsafeBinarySemaphore m_sem;
-    };
+    static void checkCount(std::size_t count);
 
-    void           enqueue(ThreadBlocker *threadBlocker) noexcept;
-    ThreadBlocker *dequeue() noexcept;
-    void           remove(ThreadBlocker *threadBlocker) noexcept;
+    bool strict() const noexcept;
+    bool isDue(const Waiter &waiter, std::chrono::steady_clock::time_point now) const noexcept;
+    bool validate(std::size_t count) noexcept;
+    void releaseNext(std::size_t update);
 
-    void releaseNext(ThreadBlocker &threadBlocker);
+    template <class Clock, class Duration>
+    bool acquireSlow(std::size_t count, const std::chrono::time_point<Clock, Duration> *abs_time);
 
-    std::size_t    m_value;
-    std::size_t    m_waiting;
-    std::size_t    m_notified;
-    ThreadBlocker *m_head;
-    ThreadBlocker *m_tail;
-    std::mutex     m_mutex;
+    const barging_policy m_policy;
+    std::atomic_size_t   m_state;
 };
 
 using fair_binary_semaphore = fair_counting_semaphore<1>;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <type_traits>
+
+namespace ext {
+template <class Clock, class Duration>
+bool posix_semaphore::try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+    if constexpr (std::is_same_v<Clock, std::chrono::system_clock>) {
+        auto since_epoch = std::chrono::ceil<std::chrono::nanoseconds>(abs_time.time_since_epoch());
+        return clockWait(CLOCK_REALTIME, since_epoch);
+    } else if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        auto since_epoch = std::chrono::ceil<std::chrono::nanoseconds>(abs_time.time_since_epoch());
+        return clockWait(CLOCK_MONOTONIC, since_epoch);
+    } else {
+        return try_acquire_until(std::chrono::steady_clock::now() + (abs_time - Clock::now()));
+    }
+}
+
+template <class Rep, class Period>
+bool posix_semaphore::try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+}
+} // namespace ext
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+
+#include <semaphore.h>
+#include <time.h>
+
+namespace ext {
+class posix_semaphore final {
+public:
+    posix_semaphore(unsigned int desired, bool pshared = false);
+
+    posix_semaphore(const posix_semaphore &)            = delete;
+    posix_semaphore &operator=(const posix_semaphore &) = delete;
+
+    void release();
+    void acquire();
+    bool try_acquire() noexcept;
+
+    template <class Clock, class Duration>
+    bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Rep, class Period>
+    bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time);
+
+    ~posix_semaphore();
+
+private:
+    bool clockWait(::clockid_t clock, std::chrono::nanoseconds abs_time);
+
+    ::sem_t m_sem;
+};
+} // namespace ext
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "std_extension/exception.hpp"
+#include "std_extension/executor.hpp"
+#include "synopsis.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace ext {
+template <class F, class... Args>
+    requires std::invocable<F, Args...>
+[[nodiscard]] std::future<std::invoke_result_t<F, Args...>>
+sharded_executor::submit_to(std::size_t shard, F &&f, Args &&...args) {
+    if (shard >= m_shards.size()) {
+        throw exception("shard index out of range");
+    }
+
+    using Result = typename std::invoke_result_t<F, Args...>;
+    std::packaged_task<Result()> task(
+        std::bind(std::forward<F>(f), detail::bind_forward<Args>(args)...));
+
+    auto res = task.get_future();
+    submit(shard, [task = std::move(task)]() mutable { task(); });
+    return res;
+}
+} // namespace ext
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "std_extension/semaphore.hpp"
+#include "std_extension/thread.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace ext {
+class sharded_executor final {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit sharded_executor(std::size_t nshards          = default_nshards(),
+                              std::size_t mailbox_capacity = 256);
+
+    sharded_executor(const sharded_executor &)            = delete;
+    sharded_executor &operator=(const sharded_executor &) = delete;
+
+    ~sharded_executor();
+
+    template <class F, class... Args>
+        requires std::invocable<F, Args...>
+    [[nodiscard]] std::future<std::invoke_result_t<F, Args...>>
+    submit_to(std::size_t shard, F &&f, Args &&...args);
+
+    void                      shutdown();
+    void                      forced_shutdown();
+    [[nodiscard]] std::size_t nshards() const noexcept;
+    [[nodiscard]] std::size_t current_shard() const noexcept;
+
+    [[nodiscard]] static std::size_t default_nshards() noexcept;
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    using Task = std::move_only_function<void()>;
+
+    enum class ShutdownPolicy {
+        FORCED,
+        GRACEFUL,
+    };
+
+    enum class State {
+        RUNNING,
+        DRAINING,
+        FINISHED,
+        FORCED,
+    };
+
+    class Mailbox final {
+    public:
+        explicit Mailbox(std::size_t capacity);
+
+        Mailbox(const Mailbox &)            = delete;
+        Mailbox &operator=(const Mailbox &) = delete;
+
+        ~Mailbox() = default;
+
+        [[nodiscard]] bool try_push(Task &task) noexcept;
+        [[nodiscard]] bool try_pop(Task &task) noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+
+    private:
+        const std::size_t       m_mask;
+        std::unique_ptr<Task[]> m_ring;
+
+        alignas(CACHE_LINE) std::atomic_size_t m_head;
+        std::size_t m_cachedTail;
+
+        alignas(CACHE_LINE) std::atomic_size_t m_tail;
+        std::size_t m_cachedHead;
+    };
+
+    struct alignas(CACHE_LINE) Shard final {
+        Shard(std::size_t nshards, std::size_t mailbox_capacity);
+
+        Shard(const Shard &)            = delete;
+        Shard &operator=(const Shard &) = delete;
+
+        ~Shard() = default;
+
+        // MARK: owned by the shard's worker
+        std::deque<Task>              m_local;
+        std::deque<Task>              m_externalBatch;
+        std::vector<std::deque<Task>> m_overflow;
+        std::atomic_size_t            m_sent;
+        std::atomic_size_t            m_done;
+
+        // MARK: written by other shards
+        std::vector<std::unique_ptr<Mailbox>> m_inboxes;
+
+        alignas(CACHE_LINE) std::atomic_bool m_sleeping;
+        binary_semaphore m_wakeup;
+
+        alignas(CACHE_LINE) std::mutex m_externalMutex;
+        std::deque<Task>   m_external;
+        std::atomic_size_t m_externalSent;
+    };
+
+    struct Current {
+        const sharded_executor *m_owner;
+        std::size_t             m_index;
+    };
+
+    static Current &current() noexcept;
+
+    void submit(std::size_t shard, Task task);
+    void submitExternal(Shard &target, Task task);
+    void submitInternal(Shard &source, std::size_t shard, Task task);
+
+    void run(std::size_t index);
+    void pin(std::size_t index) noexcept;
+    bool runBatch(Shard &shard);
+    bool flushOverflow(Shard &shard);
+    bool hasWork(Shard &shard);
+    void park(Shard &shard, State observed);
+    void wake(Shard &shard);
+    void wakeAll();
+    bool quiescent() const noexcept;
+
+    static void execute(Shard &shard, Task &task);
+
+    void shutdown(ShutdownPolicy policy);
+
+    std::atomic_long                    m_activeness;
+    std::atomic<State>                  m_state;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::vector<thread>                 m_workers;
+};
+} // namespace ext
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <memory>
+#include <type_traits>
+
+namespace ext {
+template <class Clock, class Duration>
+std::chrono::steady_clock::time_point
+shared_mutex::toSteady(const std::chrono::time_point<Clock, Duration> &abs_time) {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        return std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time);
+    } else {
+        return std::chrono::steady_clock::now() +
+               std::chrono::ceil<std::chrono::steady_clock::duration>(abs_time - Clock::now());
+    }
+}
+
+template <class Clock, class Duration>
+bool shared_mutex::try_lock_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+    std::chrono::steady_clock::time_point steady_time = toSteady(abs_time);
+    return lockUntil(std::addressof(steady_time));
+}
+
+template <class Rep, class Period>
+bool shared_mutex::try_lock_for(const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_lock_until(std::chrono::steady_clock::now() + rel_time);
+}
+
+template <class Clock, class Duration>
+bool shared_mutex::try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+    std::chrono::steady_clock::time_point steady_time = toSteady(abs_time);
+    return lockSharedUntil(std::addressof(steady_time));
+}
+
+template <class Rep, class Period>
+bool shared_mutex::try_lock_shared_for(const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_lock_shared_until(std::chrono::steady_clock::now() + rel_time);
+}
+} // namespace ext
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace ext {
+class shared_mutex final {
+public:
+    shared_mutex();
+
+    shared_mutex(const shared_mutex &)            = delete;
+    shared_mutex &operator=(const shared_mutex &) = delete;
+
+    ~shared_mutex() = default;
+
+    void lock();
+    bool try_lock();
+
+    template <class Clock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period> &rel_time);
+
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+
+    template <class Clock, class Duration>
+    bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Rep, class Period>
+    bool try_lock_shared_for(const std::chrono::duration<Rep, Period> &rel_time);
+
+    void unlock_shared();
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t MAX_SLOTS  = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic_size_t m_readers = 0;
+    };
+
+    template <class Clock, class Duration>
+    static std::chrono::steady_clock::time_point
+    toSteady(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    Slot &slot() noexcept;
+    bool  hasReaders() const noexcept;
+    bool  lockUntil(const std::chrono::steady_clock::time_point *abs_time);
+    bool  lockSharedUntil(const std::chrono::steady_clock::time_point *abs_time);
+
+    const std::size_t       m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic_bool        m_writer;
+};
+} // namespace ext
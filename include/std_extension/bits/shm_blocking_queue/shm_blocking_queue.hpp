@@ -0,0 +1,3 @@
+#pragma once
+
+#include "shm_blocking_queue.tpp"
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "synopsis.hpp"
+
+#include <memory>
+#include <new>
+
+namespace ext {
+namespace detail {
+template <class Clock, class Duration>
+bool shm_ring::try_push_until(const std::chrono::time_point<Clock, Duration> &abs_time,
+                              const void                                     *record) {
+    if (!m_header->m_semPush.try_acquire_until(abs_time)) {
+        return false;
+    }
+    commitPush(record);
+    return true;
+}
+
+template <class Clock, class Duration>
+bool shm_ring::try_pop_until(const std::chrono::time_point<Clock, Duration> &abs_time,
+                             void                                           *record) {
+    if (!m_header->m_semPop.try_acquire_until(abs_time)) {
+        return false;
+    }
+    commitPop(record);
+    return true;
+}
+} // namespace detail
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+shm_blocking_queue<E>::shm_blocking_queue(const std::string &name, std::size_t capacity)
+    : m_ring(name, capacity, sizeof(E)) {}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+void shm_blocking_queue<E>::unlink(const std::string &name) {
+    detail::shm_ring::unlink(name);
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+void shm_blocking_queue<E>::push_back(const E &element) {
+    m_ring.push(std::addressof(element));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+bool shm_blocking_queue<E>::try_push_back(const E &element) {
+    return m_ring.try_push(std::addressof(element));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+template <class Clock, class Duration>
+bool shm_blocking_queue<E>::try_push_back_until(
+    const std::chrono::time_point<Clock, Duration> &abs_time, const E &element) {
+    return m_ring.try_push_until(abs_time, std::addressof(element));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+template <class Rep, class Period>
+bool shm_blocking_queue<E>::try_push_back_for(const std::chrono::duration<Rep, Period> &rel_time,
+                                              const E                                  &element) {
+    return try_push_back_until(std::chrono::steady_clock::now() + rel_time, element);
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+E shm_blocking_queue<E>::pop_front() {
+    alignas(E) std::byte storage[sizeof(E)];
+    m_ring.pop(storage);
+    return *std::launder(reinterpret_cast<E *>(storage));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+std::optional<E> shm_blocking_queue<E>::try_pop_front() {
+    alignas(E) std::byte storage[sizeof(E)];
+    if (!m_ring.try_pop(storage)) {
+        return std::nullopt;
+    }
+    return *std::launder(reinterpret_cast<E *>(storage));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+template <class Clock, class Duration>
+std::optional<E> shm_blocking_queue<E>::try_pop_front_until(
+    const std::chrono::time_point<Clock, Duration> &abs_time) {
+    alignas(E) std::byte storage[sizeof(E)];
+    if (!m_ring.try_pop_until(abs_time, storage)) {
+        return std::nullopt;
+    }
+    return *std::launder(reinterpret_cast<E *>(storage));
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+template <class Rep, class Period>
+std::optional<E>
+shm_blocking_queue<E>::try_pop_front_for(const std::chrono::duration<Rep, Period> &rel_time) {
+    return try_pop_front_until(std::chrono::steady_clock::now() + rel_time);
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+std::size_t shm_blocking_queue<E>::size() const noexcept {
+    return m_ring.size();
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+std::size_t shm_blocking_queue<E>::capacity() const noexcept {
+    return m_ring.capacity();
+}
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+bool shm_blocking_queue<E>::empty() const noexcept {
+    return 0 == size();
+}
+} // namespace ext
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "std_extension/semaphore.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace ext {
+namespace detail {
+class shm_ring final {
+public:
+    shm_ring(const std::string &name, std::size_t capacity, std::size_t record_size);
+
+    shm_ring(const shm_ring &)            = delete;
+    shm_ring &operator=(const shm_ring &) = delete;
+
+    ~shm_ring();
+
+    static void unlink(const std::string &name);
+
+    void push(const void *record);
+    bool try_push(const void *record);
+
+    template <class Clock, class Duration>
+    bool try_push_until(const std::chrono::time_point<Clock, Duration> &abs_time,
+                        const void                                     *record);
+
+    void pop(void *record);
+    bool try_pop(void *record);
+
+    template <class Clock, class Duration>
+    bool try_pop_until(const std::chrono::time_point<Clock, Duration> &abs_time, void *record);
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct Header {
+        Header(std::size_t capacity, std::size_t record_size);
+
+        std::atomic_uint64_t                   m_magic;
+        const std::size_t                      m_capacity;
+        const std::size_t                      m_recordSize;
+        posix_semaphore                        m_semPush;
+        posix_semaphore                        m_semPop;
+        alignas(CACHE_LINE) std::atomic_size_t m_head;
+        alignas(CACHE_LINE) std::atomic_size_t m_tail;
+    };
+
+    struct Slot {
+        std::atomic_size_t m_seq;
+    };
+
+    static_assert(std::atomic_size_t::is_always_lock_free,
+                  "shared memory requires lock-free atomics");
+    static_assert(std::atomic_uint64_t::is_always_lock_free,
+                  "shared memory requires lock-free atomics");
+
+    static std::size_t strideOf(std::size_t record_size);
+    static std::size_t lengthOf(std::size_t capacity, std::size_t stride);
+
+    Slot &slot(std::size_t pos) const noexcept;
+
+    void commitPush(const void *record);
+    void commitPop(void *record);
+
+    std::size_t m_stride;
+    std::size_t m_length;
+    Header     *m_header;
+};
+} // namespace detail
+
+template <class E>
+    requires std::is_trivially_copyable_v<E>
+class shm_blocking_queue final {
+public:
+    shm_blocking_queue(const std::string &name, std::size_t capacity);
+
+    shm_blocking_queue(const shm_blocking_queue &)            = delete;
+    shm_blocking_queue &operator=(const shm_blocking_queue &) = delete;
+
+    ~shm_blocking_queue() = default;
+
+    static void unlink(const std::string &name);
+
+    void               push_back(const E &element);
+    [[nodiscard]] bool try_push_back(const E &element);
+
+    template <class Clock, class Duration>
+    [[nodiscard]] bool try_push_back_until(const std::chrono::time_point<Clock, Duration> &abs_time,
+                                           const E                                        &element);
+
+    template <class Rep, class Period>
+    [[nodiscard]] bool try_push_back_for(const std::chrono::duration<Rep, Period> &rel_time,
+                                         const E                                  &element);
+
+    [[nodiscard]] E                pop_front();
+    [[nodiscard]] std::optional<E> try_pop_front();
+
+    template <class Clock, class Duration>
+    [[nodiscard]] std::optional<E>
+    try_pop_front_until(const std::chrono::time_point<Clock, Duration> &abs_time);
+
+    template <class Rep, class Period>
+    [[nodiscard]] std::optional<E>
+    try_pop_front_for(const std::chrono::duration<Rep, Period> &rel_time);
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept;
+    [[nodiscard]] bool        empty() const noexcept;
+
+private:
+    detail::shm_ring m_ring;
+};
+} // namespace ext
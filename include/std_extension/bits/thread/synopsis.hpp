@@ -1,17 +1,22 @@
 #pragma once
 
+#include "std_extension/bits/parker/parker.hpp"
 #include "std_extension/exception.hpp"
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <shared_mutex>
 #include <thread>
-#include <unordered_map>
 
 namespace ext {
+namespace detail {
+bool wait_fd(int fd, short events, const std::chrono::steady_clock::time_point *abs_time);
+void precise_sleep_until(const std::chrono::steady_clock::time_point &abs_time,
+                         std::chrono::nanoseconds                     spin_for);
+
+inline constexpr std::chrono::microseconds PRECISE_SPIN(20);
+} // namespace detail
+
 namespace this_thread {
 void            yield() noexcept;
 std::thread::id get_id() noexcept;
@@ -21,6 +26,23 @@ void sleep_until(const std::chrono::time_point<Clock, Duration> &sleep_time);
 
 template <class Rep, class Period>
 void sleep_for(const std::chrono::duration<Rep, Period> &sleep_duration);
+
+template <class Clock, class Duration>
+void precise_sleep_until(const std::chrono::time_point<Clock, Duration> &sleep_time,
+                         std::chrono::nanoseconds spin_for = detail::PRECISE_SPIN);
+
+template <class Rep, class Period>
+void precise_sleep_for(const std::chrono::duration<Rep, Period> &sleep_duration,
+                       std::chrono::nanoseconds spin_for = detail::PRECISE_SPIN);
+
+bool wait_readable(int fd);
+bool wait_writable(int fd);
+
+template <class Rep, class Period>
+bool wait_readable(int fd, const std::chrono::duration<Rep, Period> &timeout);
+
+template <class Rep, class Period>
+bool wait_writable(int fd, const std::chrono::duration<Rep, Period> &timeout);
 } // namespace this_thread
 class thread final {
 public:
@@ -46,26 +68,35 @@ public:
 
 private:
     friend class condition_variable;
+    friend class parking_lot;
+
+    friend bool detail::wait_fd(int fd, short events,
+                                const std::chrono::steady_clock::time_point *abs_time);
+
+    friend void detail::precise_sleep_until(const std::chrono::steady_clock::time_point &abs_time,
+                                            std::chrono::nanoseconds spin_for);
 
     template <class Clock, class Duration>
     friend void
     this_thread::sleep_until(const std::chrono::time_point<Clock, Duration> &sleep_time);
 
     struct Spore {
-        template <class F, class... Args> explicit Spore(F &&f, Args &&...args);
+        Spore() noexcept;
 
         Spore(const Spore &)            = delete;
         Spore &operator=(const Spore &) = delete;
 
-        std::atomic_bool         m_interrupted;
-        std::condition_variable *m_cv_cv;
-        std::thread              m_thread;
-        std::mutex               m_mutex;
+        ~Spore();
+
+        std::atomic_bool m_interrupted;
+        std::atomic_int  m_eventfd;
+        detail::parker   m_parker;
+        std::thread      m_thread;
     };
 
-    static std::unordered_map<std::thread::id, std::shared_ptr<Spore>> &get_threads() noexcept;
-    static std::shared_mutex                                           &get_mutex() noexcept;
-    static std::shared_ptr<Spore>                                       get_spore();
+    static Spore         *&get_spore() noexcept;
+    static detail::parker &get_parker() noexcept;
+    static void            checkInterrupted(Spore &spore);
 
     std::shared_ptr<Spore> m_spore;
 };
@@ -4,37 +4,23 @@
 #include "std_extension/interrupted_exception.hpp"
 #include "synopsis.hpp"
 
+#include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+#include <poll.h>
+
 namespace ext {
 namespace this_thread {
 template <class Clock, class Duration>
 void sleep_until(const std::chrono::time_point<Clock, Duration> &sleep_time) {
-    std::shared_ptr<thread::Spore> spore = thread::get_spore();
+    thread::Spore *spore = thread::get_spore();
     if (nullptr != spore) {
-        deferred_task defer([&spore] {
-            std::lock_guard guard(spore->m_mutex);
-            spore->m_cv_cv = nullptr;
-        });
-
-        std::condition_variable cv;
-        std::mutex              mutex;
-        std::unique_lock        lock(mutex);
-
-        {
-            std::lock_guard guard(spore->m_mutex);
-            spore->m_cv_cv = std::addressof(cv);
-        }
-
-        if (spore->m_interrupted.exchange(false)) {
-            throw interrupted_exception();
-        }
-        std::cv_status status = std::cv_status::no_timeout;
-        while (std::cv_status::no_timeout == status) {
-            status = cv.wait_until(lock, sleep_time);
-            if (spore->m_interrupted.exchange(false)) {
-                throw interrupted_exception();
-            }
+        thread::checkInterrupted(*spore);
+        while (Clock::now() < sleep_time) {
+            spore->m_parker.park_until(sleep_time);
+            thread::checkInterrupted(*spore);
         }
     } else {
         std::this_thread::sleep_until(sleep_time);
@@ -45,19 +31,61 @@ template <class Rep, class Period>
 void sleep_for(const std::chrono::duration<Rep, Period> &sleep_duration) {
     sleep_until(std::chrono::steady_clock::now() + sleep_duration);
 }
+
+template <class Clock, class Duration>
+void precise_sleep_until(const std::chrono::time_point<Clock, Duration> &sleep_time,
+                         std::chrono::nanoseconds                        spin_for) {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        detail::precise_sleep_until(
+            std::chrono::ceil<std::chrono::steady_clock::duration>(sleep_time), spin_for);
+    } else {
+        auto rel_time =
+            std::chrono::ceil<std::chrono::steady_clock::duration>(sleep_time - Clock::now());
+        detail::precise_sleep_until(std::chrono::steady_clock::now() + rel_time, spin_for);
+    }
+}
+
+template <class Rep, class Period>
+void precise_sleep_for(const std::chrono::duration<Rep, Period> &sleep_duration,
+                       std::chrono::nanoseconds                  spin_for) {
+    precise_sleep_until(std::chrono::steady_clock::now() + sleep_duration, spin_for);
+}
+
+template <class Rep, class Period>
+bool wait_readable(int fd, const std::chrono::duration<Rep, Period> &timeout) {
+    auto abs_time = std::chrono::steady_clock::now() +
+                    std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+    return detail::wait_fd(fd, POLLIN, std::addressof(abs_time));
+}
+
+template <class Rep, class Period>
+bool wait_writable(int fd, const std::chrono::duration<Rep, Period> &timeout) {
+    auto abs_time = std::chrono::steady_clock::now() +
+                    std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+    return detail::wait_fd(fd, POLLOUT, std::addressof(abs_time));
+}
 } // namespace this_thread
 
-template <class F, class... Args>
-thread::Spore::Spore(F &&f, Args &&...args)
-    : m_interrupted(false)
-    , m_cv_cv(nullptr)
-    , m_thread(std::forward<F>(f), std::forward<Args>(args)...) {}
+inline thread::Spore *&thread::get_spore() noexcept {
+    thread_local constinit Spore *spore = nullptr;
+    return spore;
+}
+
+inline detail::parker &thread::get_parker() noexcept {
+    thread_local constinit detail::parker parker;
+    Spore                                *spore = get_spore();
+    return nullptr != spore ? spore->m_parker : parker;
+}
 
 template <class F, class... Args>
 thread::thread(F &&f, Args &&...args)
-    : m_spore(std::make_shared<Spore>(std::forward<F>(f), std::forward<Args>(args)...)) {
-    auto           &threads = get_threads();
-    std::lock_guard guard(get_mutex());
-    threads[get_id()] = m_spore;
+    : m_spore(std::make_shared<Spore>()) {
+    m_spore->m_thread = std::thread(
+        [spore = m_spore]<class G, class... Params>(G &&g, Params &&...params) {
+            get_spore() = spore.get();
+            deferred_task defer([] { get_spore() = nullptr; });
+            std::invoke(std::forward<G>(g), std::forward<Params>(params)...);
+        },
+        std::forward<F>(f), std::forward<Args>(args)...);
 }
 } // namespace ext
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/concurrent_queue/concurrent_queue.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/concurrent_skip_list_map/concurrent_skip_list_map.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/concurrent_unordered_map/concurrent_unordered_map.hpp"
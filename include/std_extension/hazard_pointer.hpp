@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/hazard_pointer/hazard_pointer.hpp"
@@ -1,4 +1,9 @@
 #pragma once
 
 #include "bits/memory/allocator/allocator.hpp"
+#include "bits/memory/arena/arena.hpp"
+#include "bits/memory/atomic_shared_ptr/atomic_shared_ptr.hpp"
 #include "bits/memory/make_shared/make_shared.hpp"
+#include "bits/memory/mmap_allocator/mmap_allocator.hpp"
+#include "bits/memory/pool_allocator/pool_allocator.hpp"
+#include "bits/memory/tracking_allocator/tracking_allocator.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/object_pool/object_pool.hpp"
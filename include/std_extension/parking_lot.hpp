@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/parking_lot/parking_lot.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/rate_limiter/rate_limiter.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/sharded_executor/sharded_executor.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/shared_mutex/shared_mutex.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "bits/shm_blocking_queue/shm_blocking_queue.hpp"
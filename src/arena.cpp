@@ -0,0 +1,115 @@
+#include "std_extension/memory.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace ext {
+arena::arena(std::size_t initial_size, std::pmr::memory_resource *upstream)
+    : m_upstream(upstream)
+    , m_initialSize(std::max<std::size_t>(initial_size, sizeof(Block)))
+    , m_nextSize(m_initialSize)
+    , m_head(nullptr)
+    , m_tail(nullptr)
+    , m_current(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr) {}
+
+arena::~arena() { release(); }
+
+std::byte *arena::begin(Block *block) noexcept {
+    return reinterpret_cast<std::byte *>(block) + sizeof(Block);
+}
+
+void arena::reset() noexcept {
+    m_current = m_head;
+    m_cursor  = nullptr == m_head ? nullptr : begin(m_head);
+    m_end     = nullptr == m_head ? nullptr : begin(m_head) + m_head->m_size;
+}
+
+void arena::release() noexcept {
+    for (Block *block = m_head; nullptr != block;) {
+        Block *next = block->m_next;
+        m_upstream->deallocate(block, sizeof(Block) + block->m_size, alignof(std::max_align_t));
+        block = next;
+    }
+
+    m_nextSize = m_initialSize;
+    m_head = m_tail = m_current = nullptr;
+    m_cursor = m_end = nullptr;
+}
+
+std::size_t arena::capacity() const noexcept {
+    std::size_t size = 0;
+    for (Block *block = m_head; nullptr != block; block = block->m_next) {
+        size += block->m_size;
+    }
+    return size;
+}
+
+std::pmr::memory_resource *arena::upstream_resource() const noexcept { return m_upstream; }
+
+bool arena::tryBump(std::size_t bytes, std::size_t alignment, void *&p) noexcept {
+    if (nullptr == m_cursor) {
+        return false;
+    }
+
+    void       *aligned = m_cursor;
+    std::size_t space   = static_cast<std::size_t>(m_end - m_cursor);
+    if (nullptr == std::align(alignment, bytes, aligned, space)) {
+        return false;
+    }
+
+    p        = aligned;
+    m_cursor = static_cast<std::byte *>(aligned) + bytes;
+    return true;
+}
+
+void *arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void *p = nullptr;
+    if (tryBump(bytes, alignment, p)) {
+        return p;
+    }
+
+    // MARK: reuse blocks kept by reset() before asking upstream for more
+    while (nullptr != m_current && nullptr != m_current->m_next) {
+        m_current = m_current->m_next;
+        m_cursor  = begin(m_current);
+        m_end     = m_cursor + m_current->m_size;
+        if (tryBump(bytes, alignment, p)) {
+            return p;
+        }
+    }
+
+    std::size_t size;
+    std::size_t total;
+    if (__builtin_add_overflow(bytes, alignment, &size) ||
+        __builtin_add_overflow(sizeof(Block), std::max(m_nextSize, size), &total)) {
+        throw std::bad_alloc();
+    }
+    size        = std::max(m_nextSize, size);
+    auto *block = static_cast<Block *>(m_upstream->allocate(total, alignof(std::max_align_t)));
+    block->m_next = nullptr;
+    block->m_size = size;
+    if (nullptr == m_tail) {
+        m_head = block;
+    } else {
+        m_tail->m_next = block;
+    }
+    m_tail     = block;
+    m_current  = block;
+    m_cursor   = begin(block);
+    m_end      = m_cursor + size;
+    m_nextSize = size <= std::numeric_limits<std::size_t>::max() / 2 ? size * 2 : size;
+
+    tryBump(bytes, alignment, p);
+    return p;
+}
+
+void arena::do_deallocate(void *, std::size_t, std::size_t) {}
+
+bool arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == std::addressof(other);
+}
+} // namespace ext
@@ -0,0 +1,97 @@
+#include "std_extension/barrier.hpp"
+#include "std_extension/exception.hpp"
+#include "std_extension/parking_lot.hpp"
+
+#include <functional>
+#include <thread>
+
+namespace ext {
+namespace detail {
+namespace {
+std::ptrdiff_t check_expected(std::ptrdiff_t expected) {
+    if (expected <= 0) {
+        throw exception("barrier expected count must be positive");
+    }
+    return expected;
+}
+} // namespace
+
+barrier_base::barrier_base(std::ptrdiff_t expected)
+    : m_expected(check_expected(expected))
+    , m_adjustment(0)
+    , m_phase(0)
+    , m_nodes(std::make_unique<Node[]>((m_expected + 1) >> 1)) {}
+
+barrier_base::Phase barrier_base::phase() const noexcept {
+    return m_phase.load(std::memory_order_acquire);
+}
+
+bool barrier_base::arrive(Phase old) noexcept {
+    // tournament: arrivals pair up per node, the second of each pair climbs to the next round
+    const Phase half = old + 1;
+    const Phase full = old + 2;
+
+    std::ptrdiff_t expected = m_expected;
+    std::size_t    current  = std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                          static_cast<std::size_t>((expected + 1) >> 1);
+    for (std::size_t round = 0;; ++round) {
+        if (expected <= 1) {
+            return true;
+        }
+
+        std::size_t end  = static_cast<std::size_t>((expected + 1) >> 1);
+        std::size_t last = end - 1;
+        for (;; ++current) {
+            if (current == end) {
+                current = 0;
+            }
+
+            std::atomic<Phase> &ticket = m_nodes[current].m_tickets[round];
+            Phase               value  = old;
+            if (current == last && 0 != (expected & 1)) {
+                if (ticket.compare_exchange_strong(value, full, std::memory_order_acq_rel)) {
+                    break;
+                }
+            } else if (ticket.compare_exchange_strong(value, half, std::memory_order_acq_rel)) {
+                return false;
+            } else if (half == value &&
+                       ticket.compare_exchange_strong(value, full, std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+
+        expected = static_cast<std::ptrdiff_t>(last + 1);
+        current >>= 1;
+    }
+}
+
+void barrier_base::drop() noexcept { m_adjustment.fetch_sub(1, std::memory_order_relaxed); }
+
+void barrier_base::advance(Phase old) noexcept {
+    m_expected += m_adjustment.exchange(0, std::memory_order_relaxed);
+    m_phase.store(old + 2, std::memory_order_release);
+    parking_lot::unpark_all(this);
+}
+
+void barrier_base::wait(Phase old) const {
+    while (old == m_phase.load(std::memory_order_acquire)) {
+        parking_lot::park(
+            this, 0, [this, old] { return old == m_phase.load(std::memory_order_relaxed); },
+            [] {});
+    }
+}
+
+bool barrier_base::waitUntil(Phase                                        old,
+                             const std::chrono::steady_clock::time_point &abs_time) const {
+    while (old == m_phase.load(std::memory_order_acquire)) {
+        park_result res = parking_lot::park_until(
+            this, 0, [this, old] { return old == m_phase.load(std::memory_order_relaxed); },
+            [] {}, abs_time);
+        if (park_result::TIMEOUT == res) {
+            return old != m_phase.load(std::memory_order_acquire);
+        }
+    }
+    return true;
+}
+} // namespace detail
+} // namespace ext
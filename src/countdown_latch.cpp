@@ -5,22 +5,26 @@ countdown_latch::countdown_latch(std::size_t count)
     : m_count(count) {}
 
 void countdown_latch::wait() const {
-    std::unique_lock lock(m_mutex);
-    m_cv.wait(lock, [this] { return 0 == m_count; });
+    while (0 != m_count.load(std::memory_order_acquire)) {
+        parking_lot::park(
+            this, 0, [this] { return 0 != m_count.load(std::memory_order_relaxed); }, [] {});
+    }
 }
 
 void countdown_latch::countdown() noexcept {
-    {
-        std::lock_guard guard(m_mutex);
-        if (0 == m_count || 0 != --m_count) {
+    std::size_t count = m_count.load(std::memory_order_relaxed);
+    do {
+        if (0 == count) {
             return;
         }
+    } while (!m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel));
+
+    if (1 == count) {
+        parking_lot::unpark_all(this);
     }
-    m_cv.notify_all();
 }
 
 std::size_t countdown_latch::count() const noexcept {
-    std::lock_guard guard(m_mutex);
-    return m_count;
+    return m_count.load(std::memory_order_acquire);
 }
 } // namespace ext
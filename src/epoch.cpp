@@ -0,0 +1,259 @@
+#include "std_extension/epoch.hpp"
+
+#include <unordered_map>
+#include <utility>
+
+namespace ext {
+namespace detail {
+struct epoch_record {
+    static void release(epoch &domain, epoch_record *record) noexcept {
+        domain.releaseRecord(record);
+    }
+
+    std::atomic_uint64_t       m_state   = 0; // epoch << 1 | PINNED
+    std::atomic_bool           m_inUse   = true;
+    std::size_t                m_nesting = 0;
+    std::size_t                m_retires = 0;
+    std::vector<epoch_retired> m_retired;
+    epoch_record              *m_next = nullptr;
+};
+
+namespace {
+constexpr std::uint64_t PINNED        = 1;
+constexpr std::size_t   COLLECT_EVERY = 64;
+
+// live domains by id, so exiting threads never touch a destroyed domain
+struct Domains {
+    std::mutex                                 m_mutex;
+    std::unordered_map<std::uint64_t, epoch *> m_live;
+    std::uint64_t                              m_nextId = 1;
+};
+
+Domains &domains() noexcept {
+    static Domains *domains = new Domains();
+    return *domains;
+}
+
+struct ThreadRecords {
+    ~ThreadRecords() {
+        destroyed() = true;
+        std::lock_guard guard(domains().m_mutex);
+        for (auto [id, record] : m_records) {
+            auto it = domains().m_live.find(id);
+            if (domains().m_live.end() != it) {
+                epoch_record::release(*it->second, record);
+            }
+        }
+    }
+
+    static bool &destroyed() noexcept {
+        thread_local constinit bool destroyed = false;
+        return destroyed;
+    }
+
+    std::vector<std::pair<std::uint64_t, epoch_record *>> m_records;
+};
+
+ThreadRecords *thread_records() noexcept {
+    if (ThreadRecords::destroyed()) {
+        return nullptr;
+    }
+    thread_local ThreadRecords records;
+    return &records;
+}
+
+std::uint64_t register_domain(epoch *domain) {
+    std::lock_guard guard(domains().m_mutex);
+    std::uint64_t   id    = domains().m_nextId++;
+    domains().m_live[id] = domain;
+    return id;
+}
+} // namespace
+} // namespace detail
+
+// MARK: guard
+epoch::guard::guard(epoch &domain, detail::epoch_record *record, bool release) noexcept
+    : m_domain(&domain)
+    , m_record(record)
+    , m_release(release) {}
+
+epoch::guard::guard(guard &&other) noexcept
+    : m_domain(other.m_domain)
+    , m_record(std::exchange(other.m_record, nullptr))
+    , m_release(other.m_release) {}
+
+epoch::guard::~guard() {
+    if (nullptr == m_record) {
+        return;
+    }
+    m_domain->unpin(m_record);
+    if (m_release) {
+        m_domain->releaseRecord(m_record);
+    }
+}
+
+// MARK: epoch
+epoch::epoch()
+    : m_id(detail::register_domain(this)) {}
+
+epoch::~epoch() {
+    {
+        std::lock_guard guard(detail::domains().m_mutex);
+        detail::domains().m_live.erase(m_id);
+    }
+
+    detail::epoch_record *record = m_records.load(std::memory_order_acquire);
+    while (nullptr != record) {
+        for (detail::epoch_retired &retired : record->m_retired) {
+            retired.m_reclaim(retired.m_object);
+        }
+        delete std::exchange(record, record->m_next);
+    }
+
+    for (detail::epoch_retired &retired : m_orphans) {
+        retired.m_reclaim(retired.m_object);
+    }
+}
+
+epoch &epoch::global() noexcept {
+    static epoch *domain = new epoch();
+    return *domain;
+}
+
+epoch::guard epoch::pin() {
+    detail::epoch_record *record  = threadRecord();
+    bool                  release = nullptr == record;
+    if (release) {
+        record = acquireRecord();
+    }
+
+    if (0 == record->m_nesting++) {
+        record->m_state.store(m_epoch.load(std::memory_order_relaxed) << 1 | detail::PINNED,
+                              std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return guard(*this, record, release);
+}
+
+void epoch::retire(void *p, void (*reclaim)(void *)) {
+    std::uint64_t         current = m_epoch.load(std::memory_order_seq_cst);
+    detail::epoch_record *record  = threadRecord();
+    if (nullptr == record) {
+        std::lock_guard guard(m_mutex);
+        m_orphans.push_back({p, reclaim, current});
+        return;
+    }
+
+    record->m_retired.push_back({p, reclaim, current});
+    if (++record->m_retires >= detail::COLLECT_EVERY) {
+        collect();
+    }
+}
+
+void epoch::collect() {
+    tryAdvance();
+
+    detail::epoch_record *record = threadRecord();
+    if (nullptr != record) {
+        record->m_retires = 0;
+        reclaim(record->m_retired);
+    }
+
+    std::vector<detail::epoch_retired> orphans;
+    {
+        std::lock_guard guard(m_mutex);
+        orphans.swap(m_orphans);
+    }
+    reclaim(orphans);
+    if (!orphans.empty()) {
+        std::lock_guard guard(m_mutex);
+        m_orphans.insert(m_orphans.end(), orphans.begin(), orphans.end());
+    }
+}
+
+detail::epoch_record *epoch::acquireRecord() {
+    detail::epoch_record *head = m_records.load(std::memory_order_acquire);
+    for (detail::epoch_record *record = head; nullptr != record; record = record->m_next) {
+        bool inUse = false;
+        if (!record->m_inUse.load(std::memory_order_relaxed) &&
+            record->m_inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    auto *record   = new detail::epoch_record();
+    record->m_next = head;
+    while (!m_records.compare_exchange_weak(record->m_next, record, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    return record;
+}
+
+void epoch::releaseRecord(detail::epoch_record *record) noexcept {
+    {
+        std::lock_guard guard(m_mutex);
+        m_orphans.insert(m_orphans.end(), record->m_retired.begin(), record->m_retired.end());
+    }
+    record->m_retired.clear();
+    record->m_nesting = 0;
+    record->m_retires = 0;
+    record->m_state.store(0, std::memory_order_release);
+    record->m_inUse.store(false, std::memory_order_release);
+}
+
+detail::epoch_record *epoch::threadRecord() {
+    detail::ThreadRecords *records = detail::thread_records();
+    if (nullptr == records) {
+        return nullptr;
+    }
+
+    for (auto [id, record] : records->m_records) {
+        if (m_id == id) {
+            return record;
+        }
+    }
+
+    // the list only grows on a miss, so drop the domains destroyed since the last one here
+    {
+        std::lock_guard guard(detail::domains().m_mutex);
+        std::erase_if(records->m_records, [](const auto &entry) {
+            return !detail::domains().m_live.contains(entry.first);
+        });
+    }
+
+    detail::epoch_record *record = acquireRecord();
+    records->m_records.emplace_back(m_id, record);
+    return record;
+}
+
+bool epoch::tryAdvance() noexcept {
+    std::uint64_t current = m_epoch.load(std::memory_order_seq_cst);
+    for (detail::epoch_record *record = m_records.load(std::memory_order_acquire);
+         nullptr != record; record = record->m_next) {
+        std::uint64_t state = record->m_state.load(std::memory_order_seq_cst);
+        if (0 != (state & detail::PINNED) && state >> 1 != current) {
+            return false;
+        }
+    }
+    return m_epoch.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+}
+
+void epoch::reclaim(std::vector<detail::epoch_retired> &retired) noexcept {
+    // whatever was retired two epochs ago can no longer be seen by a pinned thread
+    std::uint64_t current = m_epoch.load(std::memory_order_acquire);
+    std::erase_if(retired, [current](const detail::epoch_retired &candidate) {
+        if (candidate.m_epoch + 2 > current) {
+            return false;
+        }
+        candidate.m_reclaim(candidate.m_object);
+        return true;
+    });
+}
+
+void epoch::unpin(detail::epoch_record *record) noexcept {
+    if (0 == --record->m_nesting) {
+        record->m_state.store(record->m_state.load(std::memory_order_relaxed) & ~detail::PINNED,
+                              std::memory_order_release);
+    }
+}
+} // namespace ext
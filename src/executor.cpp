@@ -4,24 +4,39 @@
 #include <iostream>
 
 namespace ext {
-executor::executor(std::size_t nthreads)
-    : m_activeness(0) {
+executor::Idler::Idler()
+    : m_idle(false)
+    , m_next(nullptr)
+    , m_prev(nullptr)
+    , m_sem(0) {}
+
+executor::executor(std::size_t nthreads, idle_policy policy)
+    : m_policy(policy)
+    , m_activeness(0)
+    , m_nidle(0)
+    , m_head(nullptr)
+    , m_tail(nullptr) {
     if (0 == nthreads) {
         throw exception("nthreads == 0");
     }
 
+    for (std::size_t i = 0; i < nthreads; i++) {
+        m_idlers.push_back(std::make_unique<Idler>());
+    }
+
     for (std::size_t i = 0; i < nthreads; i++) try {
-            m_workers.emplace_back([this] {
+            m_workers.emplace_back([this, &idler = *m_idlers[i]] {
                 for (;;) {
-                    std::shared_ptr<std::move_only_function<State()>> task(nullptr);
+                    std::shared_ptr<Task> task(nullptr);
                     try {
-                        task = m_tasks.pop_front();
+                        task = next(idler);
                     } catch (...) {
                         return;
                     }
                     State status = (*task)();
                     while (State::STOP == status) try {
                             m_tasks.emplace_front([] { return State::STOP; });
+                            wakeOne();
                             return;
                         } catch (...) {
                             std::this_thread::yield(); // try again
@@ -58,6 +73,96 @@ void executor::forced_shutdown() { shutdown(ShutdownPolicy::FORCED); }
 
 [[nodiscard]] std::size_t executor::nthreads() const noexcept { return m_workers.size(); }
 
+std::shared_ptr<executor::Task> executor::next(Idler &idler) {
+    for (;;) {
+        if (std::shared_ptr<Task> task = m_tasks.try_pop_front()) {
+            return task;
+        }
+
+        {
+            std::lock_guard guard(m_idleMutex);
+            enqueue(std::addressof(idler));
+        }
+
+        if (std::shared_ptr<Task> task = m_tasks.try_pop_front()) {
+            bool woken = false;
+            {
+                std::lock_guard guard(m_idleMutex);
+                woken = !idler.m_idle;
+                if (!woken) {
+                    remove(std::addressof(idler));
+                }
+            }
+            if (woken) {
+                idler.m_sem.acquire(); // already released; don't leave a stale permit behind
+                wakeOne();             // pass the wakeup on
+            }
+            return task;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + m_policy.spin_for;
+        while (!idler.m_sem.try_acquire()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                idler.m_sem.acquire();
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+void executor::wakeOne() {
+    if (0 == m_nidle) {
+        return;
+    }
+
+    Idler *idler = nullptr;
+    {
+        std::lock_guard guard(m_idleMutex);
+        idler = dequeue();
+    }
+    if (nullptr != idler) {
+        idler->m_sem.release();
+    }
+}
+
+void executor::enqueue(Idler *idler) noexcept {
+    ++m_nidle;
+    idler->m_idle = true;
+    idler->m_next = nullptr;
+    idler->m_prev = m_tail;
+    if (nullptr == m_tail) {
+        m_head = m_tail = idler;
+    } else {
+        m_tail->m_next = idler;
+        m_tail         = idler;
+    }
+}
+
+executor::Idler *executor::dequeue() noexcept {
+    Idler *idler = wakeup_order::LIFO == m_policy.order ? m_tail : m_head;
+    if (nullptr != idler) {
+        remove(idler);
+    }
+    return idler;
+}
+
+void executor::remove(Idler *idler) noexcept {
+    if (nullptr != idler->m_prev) {
+        idler->m_prev->m_next = idler->m_next;
+    } else {
+        m_head = idler->m_next;
+    }
+
+    if (nullptr != idler->m_next) {
+        idler->m_next->m_prev = idler->m_prev;
+    } else {
+        m_tail = idler->m_prev;
+    }
+    idler->m_idle = false;
+    --m_nidle;
+}
+
 void executor::shutdown(ShutdownPolicy policy) {
     for (long expected = 0; !m_activeness.compare_exchange_weak(expected, -1); expected = 0) {
         if (-2 == expected) {
@@ -72,6 +177,7 @@ void executor::shutdown(ShutdownPolicy policy) {
             } else {
                 m_tasks.emplace_front([] { return State::STOP; });
             }
+            wakeOne();
             break;
         } catch (...) {
             std::this_thread::yield(); // try again
@@ -0,0 +1,228 @@
+#include "std_extension/hazard_pointer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ext {
+namespace detail {
+struct hazard_record {
+    std::atomic<const void *> m_ptr    = nullptr;
+    std::atomic_bool          m_active = true;
+    hazard_record            *m_next   = nullptr;
+};
+
+namespace {
+constexpr std::size_t CACHE_SIZE     = 8;
+constexpr std::size_t SCAN_THRESHOLD = 64;
+
+// records are never freed, so a scan can always walk the list
+std::atomic<hazard_record *> records   = nullptr;
+std::atomic_size_t           allocated = 0;
+
+// retired objects left behind by exited threads, adopted by the next scan
+struct Orphans {
+    std::mutex      m_mutex;
+    hazard_retired *m_head = nullptr;
+};
+
+Orphans &orphans() noexcept {
+    static Orphans *orphans = new Orphans();
+    return *orphans;
+}
+
+void push(hazard_retired *&list, hazard_retired *retired) noexcept {
+    retired->m_next = list;
+    list            = retired;
+}
+
+void adopt(hazard_retired *&list) noexcept {
+    hazard_retired *adopted = nullptr;
+    {
+        std::lock_guard guard(orphans().m_mutex);
+        adopted = std::exchange(orphans().m_head, nullptr);
+    }
+    while (nullptr != adopted) {
+        push(list, std::exchange(adopted, adopted->m_next));
+    }
+}
+
+void abandon(hazard_retired *list) noexcept {
+    std::lock_guard guard(orphans().m_mutex);
+    while (nullptr != list) {
+        push(orphans().m_head, std::exchange(list, list->m_next));
+    }
+}
+
+std::size_t reclaim(hazard_retired *&list) noexcept {
+    // a deleter run below may retire more objects onto list; they were unlinked after the
+    // snapshot, so they have to wait for the next scan
+    hazard_retired *pending = std::exchange(list, nullptr);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::vector<const void *> hazards;
+    try {
+        hazards.reserve(allocated.load(std::memory_order_relaxed));
+        for (hazard_record *record = records.load(std::memory_order_acquire); nullptr != record;
+             record                = record->m_next) {
+            const void *p = record->m_ptr.load(std::memory_order_acquire);
+            if (nullptr != p) {
+                hazards.push_back(p);
+            }
+        }
+    } catch (...) {
+        list = pending;
+        return SCAN_THRESHOLD;
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::size_t count = 0;
+    while (nullptr != pending) {
+        hazard_retired *retired = std::exchange(pending, pending->m_next);
+        if (std::binary_search(hazards.begin(), hazards.end(), retired->m_object)) {
+            push(list, retired);
+            ++count;
+        } else {
+            retired->m_reclaim(retired);
+        }
+    }
+    return count;
+}
+
+struct ThreadState {
+    ~ThreadState() {
+        destroyed() = true;
+        for (std::size_t i = 0; i < m_cached; ++i) {
+            m_cache[i]->m_active.store(false, std::memory_order_release);
+        }
+        reclaim(m_retired);
+        abandon(m_retired);
+    }
+
+    static bool &destroyed() noexcept {
+        thread_local constinit bool destroyed = false;
+        return destroyed;
+    }
+
+    std::array<hazard_record *, CACHE_SIZE> m_cache   = {};
+    std::size_t                             m_cached  = 0;
+    hazard_retired                         *m_retired = nullptr;
+    std::size_t                             m_count   = 0;
+};
+
+ThreadState *thread_state() noexcept {
+    if (ThreadState::destroyed()) {
+        return nullptr;
+    }
+    thread_local ThreadState state;
+    return &state;
+}
+} // namespace
+
+hazard_record *hazard_acquire() {
+    ThreadState *state = thread_state();
+    if (nullptr != state && 0 < state->m_cached) {
+        return state->m_cache[--state->m_cached];
+    }
+
+    hazard_record *head = records.load(std::memory_order_acquire);
+    for (hazard_record *record = head; nullptr != record; record = record->m_next) {
+        bool active = false;
+        if (!record->m_active.load(std::memory_order_relaxed) &&
+            record->m_active.compare_exchange_strong(active, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    auto *record   = new hazard_record();
+    record->m_next = head;
+    while (!records.compare_exchange_weak(record->m_next, record, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    allocated.fetch_add(1, std::memory_order_relaxed);
+    return record;
+}
+
+void hazard_release(hazard_record *record) noexcept {
+    record->m_ptr.store(nullptr, std::memory_order_release);
+    ThreadState *state = thread_state();
+    if (nullptr != state && state->m_cached < CACHE_SIZE) {
+        state->m_cache[state->m_cached++] = record;
+        return;
+    }
+    record->m_active.store(false, std::memory_order_release);
+}
+
+void hazard_protect(hazard_record *record, const void *p) noexcept {
+    if (nullptr == p) {
+        record->m_ptr.store(nullptr, std::memory_order_release);
+        return;
+    }
+    record->m_ptr.store(p, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void hazard_retire(hazard_retired *retired) noexcept {
+    ThreadState *state = thread_state();
+    if (nullptr == state) {
+        retired->m_next = nullptr;
+        abandon(retired);
+        return;
+    }
+
+    push(state->m_retired, retired);
+    // scanning in proportion to the record count keeps reclamation amortized O(1)
+    if (++state->m_count < SCAN_THRESHOLD + 2 * allocated.load(std::memory_order_relaxed)) {
+        return;
+    }
+    adopt(state->m_retired);
+    state->m_count = reclaim(state->m_retired);
+}
+
+bool hazard_protected(const void *p) noexcept {
+    // pairs with the fence in hazard_protect: p is already unlinked, so either the protector's
+    // re-validation fails or its hazard is visible here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (hazard_record *record = records.load(std::memory_order_acquire); nullptr != record;
+         record                = record->m_next) {
+        if (p == record->m_ptr.load(std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace detail
+
+hazard_pointer::hazard_pointer(detail::hazard_record *record) noexcept
+    : m_record(record) {}
+
+hazard_pointer::hazard_pointer(hazard_pointer &&other) noexcept
+    : m_record(std::exchange(other.m_record, nullptr)) {}
+
+hazard_pointer &hazard_pointer::operator=(hazard_pointer &&other) noexcept {
+    if (this != &other) {
+        hazard_pointer(std::move(other)).swap(*this);
+    }
+    return *this;
+}
+
+hazard_pointer::~hazard_pointer() {
+    if (nullptr != m_record) {
+        detail::hazard_release(m_record);
+    }
+}
+
+bool hazard_pointer::empty() const noexcept { return nullptr == m_record; }
+
+void hazard_pointer::reset_protection(std::nullptr_t) noexcept {
+    detail::hazard_protect(m_record, nullptr);
+}
+
+void hazard_pointer::swap(hazard_pointer &other) noexcept { std::swap(m_record, other.m_record); }
+
+hazard_pointer make_hazard_pointer() { return hazard_pointer(detail::hazard_acquire()); }
+
+void swap(hazard_pointer &lhs, hazard_pointer &rhs) noexcept { lhs.swap(rhs); }
+} // namespace ext
@@ -0,0 +1,107 @@
+#include "std_extension/memory.hpp"
+
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ext {
+namespace detail {
+namespace {
+constexpr std::size_t   HUGE_PAGE_SIZE = std::size_t(2) << 20;
+constexpr int           HUGE_PAGE_FLAG = 21 << MAP_HUGE_SHIFT;
+constexpr unsigned long MPOL_PREFERRED = 1;
+constexpr std::size_t   MAX_NUMA_NODES = 1024;
+
+std::size_t page_size() noexcept {
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+constexpr std::size_t round_up(std::size_t value, std::size_t granularity) noexcept {
+    return (value + granularity - 1) / granularity * granularity;
+}
+
+// 0 when the rounded size, plus the slack map_huge_aligned maps around it, is not representable
+std::size_t mapping_size(std::size_t bytes, const mmap_options &options) noexcept {
+    std::size_t granularity = huge_pages::NONE == options.pages ? page_size() : HUGE_PAGE_SIZE;
+    std::size_t slack       = huge_pages::NONE == options.pages ? 0 : HUGE_PAGE_SIZE;
+    std::size_t padded;
+    if (__builtin_add_overflow(bytes, granularity - 1 + slack, &padded)) {
+        return 0;
+    }
+    return round_up(bytes, granularity);
+}
+
+void *map(std::size_t length, int flags) noexcept {
+    return ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1,
+                  0);
+}
+
+void *map_huge_aligned(std::size_t length) noexcept {
+    auto *raw = static_cast<std::byte *>(map(length + HUGE_PAGE_SIZE, 0));
+    if (MAP_FAILED == static_cast<void *>(raw)) {
+        return MAP_FAILED;
+    }
+
+    auto *aligned = reinterpret_cast<std::byte *>(
+        round_up(reinterpret_cast<std::uintptr_t>(raw), HUGE_PAGE_SIZE));
+    if (aligned != raw) {
+        ::munmap(raw, static_cast<std::size_t>(aligned - raw));
+    }
+    ::munmap(aligned + length, static_cast<std::size_t>(raw + HUGE_PAGE_SIZE - aligned));
+    ::madvise(aligned, length, MADV_HUGEPAGE);
+    return aligned;
+}
+
+void bind(void *p, std::size_t length, int node) noexcept {
+    if (0 > node || static_cast<std::size_t>(node) >= MAX_NUMA_NODES) {
+        return;
+    }
+
+    unsigned long mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    // best effort: kernels without NUMA support simply keep the default policy
+    ::syscall(SYS_mbind, p, length, MPOL_PREFERRED, mask, MAX_NUMA_NODES + 1, 0);
+}
+} // namespace
+
+void *mmap_allocate(std::size_t bytes, std::size_t alignment, const mmap_options &options) {
+    if (bytes < page_size()) {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    std::size_t length = mapping_size(bytes, options);
+    if (0 == length) {
+        throw std::bad_alloc();
+    }
+
+    void *p = MAP_FAILED;
+    if (huge_pages::EXPLICIT == options.pages) {
+        p = map(length, MAP_HUGETLB | HUGE_PAGE_FLAG);
+    }
+
+    if (MAP_FAILED == p) {
+        p = huge_pages::NONE == options.pages ? map(length, 0) : map_huge_aligned(length);
+    }
+
+    if (MAP_FAILED == p) {
+        throw std::bad_alloc();
+    }
+
+    bind(p, length, options.numa_node);
+    return p;
+}
+
+void mmap_deallocate(void *p, std::size_t bytes, std::size_t alignment,
+                     const mmap_options &options) noexcept {
+    if (bytes < page_size()) {
+        ::operator delete(p, bytes, std::align_val_t(alignment));
+        return;
+    }
+    ::munmap(p, mapping_size(bytes, options));
+}
+} // namespace detail
+} // namespace ext
@@ -0,0 +1,64 @@
+#include "std_extension/bits/parker/parker.hpp"
+
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ext {
+namespace detail {
+static void futex_wait(std::atomic_uint32_t *word, std::uint32_t expected,
+                       const ::timespec *abs_time) noexcept {
+    ::syscall(SYS_futex, word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, expected, abs_time, nullptr,
+              FUTEX_BITSET_MATCH_ANY);
+}
+
+static void futex_wake(std::atomic_uint32_t *word, int count) noexcept {
+    ::syscall(SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count);
+}
+
+void parker::park() noexcept {
+    if (NOTIFIED == m_state.fetch_sub(1, std::memory_order_acquire)) {
+        return;
+    }
+
+    for (;;) {
+        futex_wait(&m_state, PARKED, nullptr);
+        std::uint32_t expected = NOTIFIED;
+        if (m_state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+bool parker::parkUntil(const std::chrono::steady_clock::time_point &abs_time) noexcept {
+    if (NOTIFIED == m_state.fetch_sub(1, std::memory_order_acquire)) {
+        return true;
+    }
+
+    auto     nanos = abs_time.time_since_epoch();
+    auto     secs  = std::chrono::duration_cast<std::chrono::seconds>(nanos);
+    timespec ts{};
+    if (nanos.count() > 0) {
+        ts.tv_sec  = secs.count();
+        ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(nanos - secs).count();
+    }
+
+    while (std::chrono::steady_clock::now() < abs_time) {
+        futex_wait(&m_state, PARKED, &ts);
+        std::uint32_t expected = NOTIFIED;
+        if (m_state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return NOTIFIED == m_state.exchange(EMPTY, std::memory_order_acquire);
+}
+
+void parker::unpark() noexcept {
+    if (PARKED == m_state.exchange(NOTIFIED, std::memory_order_release)) {
+        futex_wake(&m_state, 1);
+    }
+}
+} // namespace detail
+} // namespace ext
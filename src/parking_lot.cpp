@@ -0,0 +1,179 @@
+#include "std_extension/parking_lot.hpp"
+#include "std_extension/thread.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace ext {
+namespace {
+struct WaitNode final {
+    WaitNode(const void *key, std::uintptr_t data, detail::parker &parker) noexcept
+        : m_key(key)
+        , m_data(data)
+        , m_parker(parker)
+        , m_unparked(false)
+        , m_next(nullptr)
+        , m_prev(nullptr) {}
+
+    WaitNode(const WaitNode &)            = delete;
+    WaitNode &operator=(const WaitNode &) = delete;
+
+    const void      *m_key;
+    std::uintptr_t   m_data;
+    detail::parker  &m_parker;
+    std::atomic_bool m_unparked;
+    WaitNode        *m_next;
+    WaitNode        *m_prev;
+};
+
+struct alignas(64) Bucket final {
+    void enqueue(WaitNode *node) noexcept {
+        node->m_prev = m_tail;
+        if (nullptr == m_tail) {
+            m_head = m_tail = node;
+        } else {
+            m_tail->m_next = node;
+            m_tail         = node;
+        }
+    }
+
+    void remove(WaitNode *node) noexcept {
+        if (nullptr != node->m_prev) {
+            node->m_prev->m_next = node->m_next;
+        } else {
+            m_head = node->m_next;
+        }
+
+        if (nullptr != node->m_next) {
+            node->m_next->m_prev = node->m_prev;
+        } else {
+            m_tail = node->m_prev;
+        }
+    }
+
+    std::mutex m_mutex;
+    WaitNode  *m_head = nullptr;
+    WaitNode  *m_tail = nullptr;
+};
+
+constexpr std::size_t BUCKETS_BITS = 10;
+
+Bucket &bucket_for(const void *key) noexcept {
+    static std::array<Bucket, std::size_t(1) << BUCKETS_BITS> buckets;
+
+    auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+    hash *= 0x9E3779B97F4A7C15ull;
+    return buckets[hash >> (64 - BUCKETS_BITS)];
+}
+} // namespace
+
+park_result parking_lot::parkImpl(const void *key, std::uintptr_t data,
+                                  FunctionRef<bool()> validate, FunctionRef<void()> before_sleep,
+                                  const std::chrono::steady_clock::time_point *abs_time) {
+    thread::Spore *spore = thread::get_spore();
+    if (nullptr != spore) {
+        thread::checkInterrupted(*spore);
+    }
+
+    WaitNode node(key, data, thread::get_parker());
+    Bucket  &bucket = bucket_for(key);
+    {
+        std::lock_guard guard(bucket.m_mutex);
+        if (!validate()) {
+            return park_result::SKIPPED;
+        }
+        bucket.enqueue(std::addressof(node));
+    }
+
+    before_sleep();
+
+    park_result res = park_result::UNPARKED;
+    while (!node.m_unparked.load(std::memory_order_acquire)) {
+        if (nullptr != spore && spore->m_interrupted.load()) {
+            break;
+        }
+        if (nullptr == abs_time) {
+            node.m_parker.park();
+        } else if (!node.m_parker.park_until(*abs_time) &&
+                   std::chrono::steady_clock::now() >= *abs_time) {
+            res = park_result::TIMEOUT;
+            break;
+        }
+    }
+
+    {
+        // the unparker holds the bucket lock until it is done with our parker, so even an early
+        // wakeup that already sees m_unparked must not leave before taking it
+        std::lock_guard guard(bucket.m_mutex);
+        if (node.m_unparked.load(std::memory_order_acquire)) {
+            return park_result::UNPARKED;
+        }
+        bucket.remove(std::addressof(node));
+    }
+
+    if (nullptr != spore) {
+        thread::checkInterrupted(*spore);
+    }
+    return res;
+}
+
+void parking_lot::unparkImpl(const void                                *key,
+                             FunctionRef<unpark_control(std::uintptr_t)> callback,
+                             FunctionRef<void(bool)>                     finish) {
+    Bucket         &bucket = bucket_for(key);
+    std::lock_guard guard(bucket.m_mutex);
+
+    bool hasMore = false;
+    for (WaitNode *node = bucket.m_head; nullptr != node;) {
+        WaitNode *next = node->m_next;
+        if (key != node->m_key) {
+            node = next;
+            continue;
+        }
+
+        unpark_control control = callback(node->m_data);
+        if (unpark_control::REMOVE_CONTINUE == control || unpark_control::REMOVE_BREAK == control) {
+            bucket.remove(node);
+            detail::parker &parker = node->m_parker;
+            node->m_unparked.store(true, std::memory_order_release);
+            parker.unpark();
+        } else {
+            hasMore = true;
+        }
+
+        node = next;
+        if (unpark_control::RETAIN_BREAK == control || unpark_control::REMOVE_BREAK == control) {
+            for (; nullptr != node && !hasMore; node = node->m_next) {
+                hasMore = key == node->m_key;
+            }
+            break;
+        }
+    }
+    finish(hasMore);
+}
+
+bool parking_lot::unpark_one(const void *key) {
+    bool unparked = false;
+    unpark(
+        key,
+        [&unparked](std::uintptr_t) {
+            unparked = true;
+            return unpark_control::REMOVE_BREAK;
+        },
+        [](bool) {});
+    return unparked;
+}
+
+std::size_t parking_lot::unpark_all(const void *key) {
+    std::size_t count = 0;
+    unpark(
+        key,
+        [&count](std::uintptr_t) {
+            ++count;
+            return unpark_control::REMOVE_CONTINUE;
+        },
+        [](bool) {});
+    return count;
+}
+} // namespace ext
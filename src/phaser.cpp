@@ -0,0 +1,100 @@
+#include "std_extension/phaser.hpp"
+#include "std_extension/exception.hpp"
+#include "std_extension/parking_lot.hpp"
+
+namespace ext {
+constexpr std::uint32_t phaser::phaseOf(std::uint64_t state) noexcept {
+    return static_cast<std::uint32_t>(state >> PHASE_SHIFT);
+}
+
+constexpr std::uint64_t phaser::partiesOf(std::uint64_t state) noexcept {
+    return (state >> PARTIES_SHIFT) & MAX_PARTIES;
+}
+
+constexpr std::uint64_t phaser::unarrivedOf(std::uint64_t state) noexcept {
+    return state & MAX_PARTIES;
+}
+
+phaser::phaser(std::size_t parties)
+    : m_state(0) {
+    bulk_register(parties);
+}
+
+std::uint32_t phaser::register_party() { return bulk_register(1); }
+
+std::uint32_t phaser::bulk_register(std::size_t parties) {
+    std::uint64_t state = m_state.load(std::memory_order_relaxed);
+    do {
+        if (parties > MAX_PARTIES - partiesOf(state)) {
+            throw exception("phaser has too many parties");
+        }
+    } while (!m_state.compare_exchange_weak(state, state + (parties << PARTIES_SHIFT) + parties,
+                                            std::memory_order_acq_rel));
+    return phaseOf(state);
+}
+
+std::uint32_t phaser::arrive() { return arriveImpl(0); }
+
+std::uint32_t phaser::arrive_and_deregister() { return arriveImpl(1); }
+
+std::uint32_t phaser::arrive_and_await_advance() { return await_advance(arriveImpl(0)); }
+
+std::uint32_t phaser::arriveImpl(std::uint64_t deregister) {
+    std::uint64_t state = m_state.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        if (0 == unarrivedOf(state)) {
+            throw exception("phaser has no unarrived parties");
+        }
+
+        std::uint64_t parties = partiesOf(state) - deregister;
+        if (1 == unarrivedOf(state)) {
+            next = (static_cast<std::uint64_t>(phaseOf(state) + 1) << PHASE_SHIFT) |
+                   (parties << PARTIES_SHIFT) | parties;
+        } else {
+            next = state - (deregister << PARTIES_SHIFT) - 1;
+        }
+    } while (!m_state.compare_exchange_weak(state, next, std::memory_order_acq_rel));
+
+    if (phaseOf(state) != phaseOf(next)) {
+        parking_lot::unpark_all(this);
+    }
+    return phaseOf(state);
+}
+
+std::uint32_t phaser::await_advance(std::uint32_t phase) const {
+    awaitUntil(phase, nullptr);
+    return this->phase();
+}
+
+bool phaser::awaitUntil(std::uint32_t                                phase,
+                        const std::chrono::steady_clock::time_point *abs_time) const {
+    auto validate = [this, phase] { return phase == this->phase(); };
+    while (validate()) {
+        if (nullptr == abs_time) {
+            parking_lot::park(this, 0, validate, [] {});
+        } else if (park_result::TIMEOUT ==
+                   parking_lot::park_until(this, 0, validate, [] {}, *abs_time)) {
+            return !validate();
+        }
+    }
+    return true;
+}
+
+std::uint32_t phaser::phase() const noexcept {
+    return phaseOf(m_state.load(std::memory_order_acquire));
+}
+
+std::size_t phaser::registered_parties() const noexcept {
+    return partiesOf(m_state.load(std::memory_order_relaxed));
+}
+
+std::size_t phaser::arrived_parties() const noexcept {
+    std::uint64_t state = m_state.load(std::memory_order_relaxed);
+    return partiesOf(state) - unarrivedOf(state);
+}
+
+std::size_t phaser::unarrived_parties() const noexcept {
+    return unarrivedOf(m_state.load(std::memory_order_relaxed));
+}
+} // namespace ext
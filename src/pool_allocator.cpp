@@ -0,0 +1,179 @@
+#include "std_extension/memory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <new>
+
+namespace ext {
+namespace detail {
+namespace {
+constexpr std::size_t CACHE_LINE = 64;
+constexpr std::size_t CLASSES    = POOL_MAX_SIZE / POOL_GRANULE;
+constexpr std::size_t SLAB_SIZE  = 64 * 1024;
+constexpr std::size_t BATCH_SIZE = 8 * 1024;
+
+struct Block {
+    Block *m_next;
+    Block *m_nextBatch;
+};
+
+static_assert(sizeof(Block) <= POOL_GRANULE);
+
+constexpr std::size_t class_of(std::size_t bytes) noexcept {
+    return (std::max<std::size_t>(bytes, 1) + POOL_GRANULE - 1) / POOL_GRANULE - 1;
+}
+
+constexpr std::size_t size_of(std::size_t index) noexcept { return (index + 1) * POOL_GRANULE; }
+
+constexpr std::size_t batch_of(std::size_t index) noexcept {
+    return std::clamp<std::size_t>(BATCH_SIZE / size_of(index), 4, 64);
+}
+
+// MARK: central pool, shared by all threads and traded with in whole batches
+struct alignas(CACHE_LINE) Central {
+    Block *take(std::size_t index) {
+        {
+            std::lock_guard guard(m_mutex);
+            if (nullptr != m_batches) {
+                Block *batch = m_batches;
+                m_batches    = batch->m_nextBatch;
+                return batch;
+            }
+        }
+        return carve(index);
+    }
+
+    void give(Block *batch) noexcept {
+        std::lock_guard guard(m_mutex);
+        batch->m_nextBatch = m_batches;
+        m_batches          = batch;
+    }
+
+    Block *carve(std::size_t index) {
+        std::size_t size  = size_of(index);
+        std::size_t count = batch_of(index);
+        std::byte  *begin = nullptr;
+        {
+            std::lock_guard guard(m_mutex);
+            if (static_cast<std::size_t>(m_end - m_cursor) < size * count) {
+                m_cursor = static_cast<std::byte *>(::operator new(SLAB_SIZE));
+                m_end    = m_cursor + SLAB_SIZE;
+            }
+            begin = m_cursor;
+            m_cursor += size * count;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto *block   = reinterpret_cast<Block *>(begin + i * size);
+            block->m_next = reinterpret_cast<Block *>(begin + (i + 1) * size);
+        }
+        reinterpret_cast<Block *>(begin + (count - 1) * size)->m_next = nullptr;
+        return reinterpret_cast<Block *>(begin);
+    }
+
+    std::mutex m_mutex;
+    Block     *m_batches = nullptr;
+    std::byte *m_cursor  = nullptr;
+    std::byte *m_end     = nullptr;
+};
+
+Central &central(std::size_t index) noexcept {
+    static std::array<Central, CLASSES> centrals;
+    return centrals[index];
+}
+
+// MARK: per-thread cache, refilled and drained one batch at a time
+struct ThreadCache {
+    struct List {
+        Block      *m_head  = nullptr;
+        std::size_t m_count = 0;
+    };
+
+    ~ThreadCache() {
+        for (std::size_t index = 0; index < CLASSES; ++index) {
+            if (nullptr != m_lists[index].m_head) {
+                central(index).give(m_lists[index].m_head);
+            }
+        }
+        destroyed() = true;
+    }
+
+    static bool &destroyed() noexcept {
+        thread_local constinit bool destroyed = false;
+        return destroyed;
+    }
+
+    void *allocate(std::size_t index) {
+        List &list = m_lists[index];
+        if (nullptr == list.m_head) {
+            list.m_head  = central(index).take(index);
+            list.m_count = 0;
+            for (Block *block = list.m_head; nullptr != block; block = block->m_next) {
+                ++list.m_count;
+            }
+        }
+
+        Block *block = list.m_head;
+        list.m_head  = block->m_next;
+        --list.m_count;
+        return block;
+    }
+
+    void deallocate(void *p, std::size_t index) noexcept {
+        List &list    = m_lists[index];
+        auto *block   = static_cast<Block *>(p);
+        block->m_next = list.m_head;
+        list.m_head   = block;
+        if (++list.m_count < 2 * batch_of(index)) {
+            return;
+        }
+
+        // hand the oldest half back so a consumer thread does not hoard a producer's blocks
+        Block *last = list.m_head;
+        for (std::size_t i = 1; i < batch_of(index); ++i) {
+            last = last->m_next;
+        }
+        central(index).give(last->m_next);
+        last->m_next = nullptr;
+        list.m_count = batch_of(index);
+    }
+
+    std::array<List, CLASSES> m_lists;
+};
+
+ThreadCache *thread_cache() noexcept {
+    if (ThreadCache::destroyed()) {
+        return nullptr;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+}
+} // namespace
+
+void *pool_allocate(std::size_t bytes) {
+    std::size_t  index = class_of(bytes);
+    ThreadCache *cache = thread_cache();
+    if (nullptr == cache) {
+        Block *batch = central(index).take(index);
+        if (nullptr != batch->m_next) {
+            central(index).give(batch->m_next);
+        }
+        return batch;
+    }
+    return cache->allocate(index);
+}
+
+void pool_deallocate(void *p, std::size_t bytes) noexcept {
+    std::size_t  index = class_of(bytes);
+    ThreadCache *cache = thread_cache();
+    if (nullptr == cache) {
+        auto *block   = static_cast<Block *>(p);
+        block->m_next = nullptr;
+        central(index).give(block);
+        return;
+    }
+    cache->deallocate(p, index);
+}
+} // namespace detail
+} // namespace ext
@@ -1,10 +1,11 @@
 #include "std_extension/semaphore.hpp"
 
+#include <cerrno>
 #include <system_error>
 
 namespace ext {
-posix_semaphore::posix_semaphore(unsigned int desired) {
-    if (::sem_init(&m_sem, 0, desired) != 0) {
+posix_semaphore::posix_semaphore(unsigned int desired, bool pshared) {
+    if (::sem_init(&m_sem, pshared ? 1 : 0, desired) != 0) {
         throw std::system_error(std::make_error_code(std::errc(errno)));
     }
 }
@@ -23,5 +24,30 @@ void posix_semaphore::acquire() {
 
 bool posix_semaphore::try_acquire() noexcept { return ::sem_trywait(&m_sem) == 0; }
 
+bool posix_semaphore::clockWait(::clockid_t clock, std::chrono::nanoseconds abs_time) {
+    auto       secs = std::chrono::duration_cast<std::chrono::seconds>(abs_time);
+    ::timespec ts{};
+    if (abs_time.count() > 0) {
+        ts.tv_sec  = secs.count();
+        ts.tv_nsec = (abs_time - secs).count();
+    }
+
+    for (;;) {
+        int res = CLOCK_REALTIME == clock ? ::sem_timedwait(&m_sem, &ts)
+                                          : ::sem_clockwait(&m_sem, clock, &ts);
+        if (0 == res) {
+            return true;
+        }
+
+        if (ETIMEDOUT == errno) {
+            return false;
+        }
+
+        if (EINTR != errno) {
+            throw std::system_error(std::make_error_code(std::errc(errno)));
+        }
+    }
+}
+
 posix_semaphore::~posix_semaphore() { ::sem_destroy(&m_sem); }
 } // namespace ext
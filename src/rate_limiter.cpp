@@ -0,0 +1,85 @@
+#include "std_extension/rate_limiter.hpp"
+#include "std_extension/exception.hpp"
+#include "std_extension/thread.hpp"
+#include "std_extension/unexpected_deferred_task.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ext {
+rate_limiter::rate_limiter(double rate, std::size_t burst)
+    : m_interval(intervalOf(rate, burst))
+    , m_burst(burst)
+    , m_tat(std::numeric_limits<std::int64_t>::min()) {}
+
+void rate_limiter::acquire(std::size_t count) {
+    // with no deadline, a reservation only fails when the cost is not representable
+    if (!waitUntil(count, TimePoint::max())) {
+        throw exception("rate_limiter count is too large");
+    }
+}
+
+bool rate_limiter::try_acquire(std::size_t count) noexcept {
+    TimePoint ready;
+    return reserve(count, std::chrono::steady_clock::now(), ready);
+}
+
+double rate_limiter::rate() const noexcept { return 1e9 / m_interval.count(); }
+
+std::size_t rate_limiter::burst() const noexcept { return m_burst; }
+
+std::chrono::nanoseconds rate_limiter::intervalOf(double rate, std::size_t burst) {
+    if (!std::isgreater(rate, 0.0) || 0 == burst) {
+        throw exception("rate_limiter rate and burst must be positive");
+    }
+    // 2^63 is exact as a double, so anything below it rounds into an int64_t
+    double interval = 1e9 / rate;
+    if (!std::isless(interval, 0x1p63)) {
+        throw exception("rate_limiter rate is too small");
+    }
+
+    std::int64_t nanos = std::max<std::int64_t>(1, std::llround(interval));
+    if (burst > static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max() / nanos)) {
+        throw exception("rate_limiter burst is too large for the rate");
+    }
+    return std::chrono::nanoseconds(nanos);
+}
+
+bool rate_limiter::reserve(std::size_t count, TimePoint deadline, TimePoint &ready) noexcept {
+    std::int64_t now = TimePoint(std::chrono::steady_clock::now()).time_since_epoch().count();
+    std::int64_t tat = m_tat.load(std::memory_order_relaxed);
+    if (count > static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max() /
+                                         m_interval.count())) {
+        return false;
+    }
+
+    // the constructor bounds m_burst the same way, so neither product overflows
+    std::int64_t cost      = static_cast<std::int64_t>(count) * m_interval.count();
+    std::int64_t tolerance = static_cast<std::int64_t>(m_burst) * m_interval.count();
+
+    // a deadline that already passed still gets the permits that are available right now
+    std::int64_t limit = std::max(deadline.time_since_epoch().count(), now);
+    std::int64_t next;
+    do {
+        if (__builtin_add_overflow(std::max(tat, now), cost, &next) || next - tolerance > limit) {
+            return false;
+        }
+    } while (!m_tat.compare_exchange_weak(tat, next, std::memory_order_relaxed));
+
+    ready = TimePoint(std::chrono::nanoseconds(next - tolerance));
+    return true;
+}
+
+bool rate_limiter::waitUntil(std::size_t count, TimePoint deadline) {
+    TimePoint ready;
+    if (!reserve(count, deadline, ready)) {
+        return false;
+    }
+
+    unexpected_deferred_task refund(
+        [this, count] { m_tat.fetch_sub(count * m_interval.count(), std::memory_order_relaxed); });
+    this_thread::sleep_until(ready);
+    return true;
+}
+} // namespace ext
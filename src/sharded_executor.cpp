@@ -0,0 +1,355 @@
+#include "std_extension/sharded_executor.hpp"
+#include "std_extension/deferred_task.hpp"
+#include "std_extension/exception.hpp"
+#include "std_extension/unexpected_deferred_task.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace ext {
+static constexpr std::size_t BATCH_SIZE = 64;
+
+sharded_executor::Mailbox::Mailbox(std::size_t capacity)
+    : m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+    , m_ring(std::make_unique<Task[]>(m_mask + 1))
+    , m_head(0)
+    , m_cachedTail(0)
+    , m_tail(0)
+    , m_cachedHead(0) {}
+
+bool sharded_executor::Mailbox::try_push(Task &task) noexcept {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead > m_mask) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead > m_mask) {
+            return false;
+        }
+    }
+    m_ring[tail & m_mask] = std::move(task);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool sharded_executor::Mailbox::try_pop(Task &task) noexcept {
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cachedTail) {
+            return false;
+        }
+    }
+    task                  = std::move(m_ring[head & m_mask]);
+    m_ring[head & m_mask] = nullptr;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool sharded_executor::Mailbox::empty() const noexcept {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
+
+sharded_executor::Shard::Shard(std::size_t nshards, std::size_t mailbox_capacity)
+    : m_overflow(nshards)
+    , m_sent(0)
+    , m_done(0)
+    , m_inboxes(nshards)
+    , m_sleeping(false)
+    , m_wakeup(0)
+    , m_externalSent(0) {
+    for (auto &inbox : m_inboxes) {
+        inbox = std::make_unique<Mailbox>(mailbox_capacity);
+    }
+}
+
+sharded_executor::Current &sharded_executor::current() noexcept {
+    thread_local Current current{nullptr, npos};
+    return current;
+}
+
+std::size_t sharded_executor::default_nshards() noexcept {
+    ::cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 == ::sched_getaffinity(0, sizeof(allowed), &allowed)) {
+        return std::max(1, CPU_COUNT(&allowed));
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+sharded_executor::sharded_executor(std::size_t nshards, std::size_t mailbox_capacity)
+    : m_activeness(0)
+    , m_state(State::RUNNING) {
+    if (0 == nshards) {
+        throw exception("nshards == 0");
+    }
+
+    m_shards.reserve(nshards);
+    for (std::size_t i = 0; i < nshards; i++) {
+        m_shards.push_back(std::make_unique<Shard>(nshards, mailbox_capacity));
+    }
+
+    m_workers.reserve(nshards);
+    for (std::size_t i = 0; i < nshards; i++) try {
+            m_workers.emplace_back([this, i] { run(i); });
+        } catch (...) {
+            m_activeness = -2;
+            m_state      = State::FORCED;
+            for (thread &worker : m_workers) {
+                worker.interrupt();
+            }
+            for (thread &worker : m_workers) {
+                worker.join();
+            }
+            throw;
+        }
+}
+
+sharded_executor::~sharded_executor() {
+    if (0 <= m_activeness) {
+        std::cerr << "Error: " << "ext::sharded_executor(" << m_shards.size()
+                  << ") has been destructed while it's still active.\n"
+                  << "Call std::terminate();" << std::endl;
+        std::terminate();
+    }
+    while (-2 != m_activeness) {
+        std::this_thread::yield();
+    }
+}
+
+void sharded_executor::shutdown() { shutdown(ShutdownPolicy::GRACEFUL); }
+
+void sharded_executor::forced_shutdown() { shutdown(ShutdownPolicy::FORCED); }
+
+[[nodiscard]] std::size_t sharded_executor::nshards() const noexcept { return m_shards.size(); }
+
+[[nodiscard]] std::size_t sharded_executor::current_shard() const noexcept {
+    const Current &cur = current();
+    return this == cur.m_owner ? cur.m_index : npos;
+}
+
+void sharded_executor::submit(std::size_t shard, Task task) {
+    const Current &cur = current();
+    if (this == cur.m_owner) {
+        submitInternal(*m_shards[cur.m_index], shard, std::move(task));
+        return;
+    }
+
+    long expected = 0;
+    while (!m_activeness.compare_exchange_weak(expected, std::max(expected, expected + 1))) {
+        if (0 > expected) {
+            throw exception("sharded_executor is inactive");
+        }
+    }
+
+    deferred_task defer([this] { --m_activeness; });
+    if (std::numeric_limits<long>::max() == expected) {
+        throw exception("sharded_executor has reached its max capacity");
+    }
+    submitExternal(*m_shards[shard], std::move(task));
+}
+
+void sharded_executor::submitExternal(Shard &target, Task task) {
+    {
+        std::lock_guard          guard(target.m_externalMutex);
+        unexpected_deferred_task undo([&target] { --target.m_externalSent; });
+        ++target.m_externalSent;
+        target.m_external.push_back(std::move(task));
+    }
+    wake(target);
+}
+
+void sharded_executor::submitInternal(Shard &source, std::size_t shard, Task task) {
+    Shard                   &target = *m_shards[shard];
+    unexpected_deferred_task undo([&source] { --source.m_sent; });
+    ++source.m_sent;
+    if (&source == &target) {
+        source.m_local.push_back(std::move(task));
+        return;
+    }
+
+    auto &overflow = source.m_overflow[shard];
+    if (overflow.empty() && target.m_inboxes[current().m_index]->try_push(task)) {
+        wake(target);
+        return;
+    }
+    overflow.push_back(std::move(task));
+}
+
+void sharded_executor::execute(Shard &shard, Task &task) {
+    task();
+    task = nullptr;
+    ++shard.m_done;
+}
+
+void sharded_executor::run(std::size_t index) {
+    Shard &shard = *m_shards[index];
+    pin(index);
+    current() = Current{this, index};
+
+    try {
+        for (;;) {
+            State state = m_state.load();
+            if (State::FORCED == state || State::FINISHED == state) {
+                return;
+            }
+
+            bool progressed = runBatch(shard);
+            progressed      = flushOverflow(shard) || progressed;
+            if (progressed) {
+                continue;
+            }
+
+            if (std::ranges::any_of(shard.m_overflow, [](auto &q) { return !q.empty(); })) {
+                std::this_thread::yield(); // the receiver is behind, try again
+                continue;
+            }
+
+            if (State::DRAINING == state && quiescent()) {
+                if (m_state.compare_exchange_strong(state, State::FINISHED)) {
+                    wakeAll();
+                }
+                return;
+            }
+
+            park(shard, state);
+        }
+    } catch (...) {
+        return;
+    }
+}
+
+void sharded_executor::pin(std::size_t index) noexcept {
+    ::cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != ::sched_getaffinity(0, sizeof(allowed), &allowed)) {
+        return;
+    }
+
+    std::size_t skip = index % std::max(1, CPU_COUNT(&allowed));
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || 0 != skip--) {
+            continue;
+        }
+        ::cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpu, &mask);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(mask), &mask);
+        return;
+    }
+}
+
+bool sharded_executor::runBatch(Shard &shard) {
+    bool progressed = false;
+    Task task;
+
+    for (auto &inbox : shard.m_inboxes) {
+        for (std::size_t i = 0; i < BATCH_SIZE && inbox->try_pop(task); i++) {
+            execute(shard, task);
+            progressed = true;
+        }
+    }
+
+    {
+        std::lock_guard guard(shard.m_externalMutex);
+        shard.m_externalBatch.swap(shard.m_external);
+    }
+    for (; !shard.m_externalBatch.empty(); shard.m_externalBatch.pop_front()) {
+        execute(shard, shard.m_externalBatch.front());
+        progressed = true;
+    }
+
+    for (std::size_t i = 0; i < BATCH_SIZE && !shard.m_local.empty(); i++) {
+        task = std::move(shard.m_local.front());
+        shard.m_local.pop_front();
+        execute(shard, task);
+        progressed = true;
+    }
+    return progressed;
+}
+
+bool sharded_executor::flushOverflow(Shard &shard) {
+    bool        progressed = false;
+    std::size_t source     = current().m_index;
+    for (std::size_t i = 0; i < shard.m_overflow.size(); i++) {
+        auto &overflow = shard.m_overflow[i];
+        if (overflow.empty()) {
+            continue;
+        }
+
+        Mailbox &inbox  = *m_shards[i]->m_inboxes[source];
+        bool     pushed = false;
+        while (!overflow.empty() && inbox.try_push(overflow.front())) {
+            overflow.pop_front();
+            pushed = true;
+        }
+        if (pushed) {
+            wake(*m_shards[i]);
+            progressed = true;
+        }
+    }
+    return progressed;
+}
+
+bool sharded_executor::hasWork(Shard &shard) {
+    if (!shard.m_local.empty() ||
+        std::ranges::any_of(shard.m_inboxes, [](auto &inbox) { return !inbox->empty(); })) {
+        return true;
+    }
+    std::lock_guard guard(shard.m_externalMutex);
+    return !shard.m_external.empty();
+}
+
+void sharded_executor::park(Shard &shard, State observed) {
+    shard.m_sleeping = true;
+    deferred_task defer([&shard] { shard.m_sleeping = false; });
+    if (observed != m_state.load() || hasWork(shard)) {
+        return;
+    }
+    shard.m_wakeup.acquire();
+}
+
+void sharded_executor::wake(Shard &shard) {
+    if (shard.m_sleeping.exchange(false)) {
+        shard.m_wakeup.release();
+    }
+}
+
+void sharded_executor::wakeAll() {
+    for (auto &shard : m_shards) {
+        wake(*shard);
+    }
+}
+
+bool sharded_executor::quiescent() const noexcept {
+    std::size_t done = 0;
+    for (auto &shard : m_shards) {
+        done += shard->m_done.load();
+    }
+
+    std::size_t sent = 0;
+    for (auto &shard : m_shards) {
+        sent += shard->m_sent.load() + shard->m_externalSent.load();
+    }
+    return done == sent;
+}
+
+void sharded_executor::shutdown(ShutdownPolicy policy) {
+    for (long expected = 0; !m_activeness.compare_exchange_weak(expected, -1); expected = 0) {
+        if (-2 == expected) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    m_state = ShutdownPolicy::GRACEFUL == policy ? State::DRAINING : State::FORCED;
+    wakeAll();
+
+    for (thread &worker : m_workers) {
+        worker.join();
+    }
+    m_activeness = -2;
+}
+} // namespace ext
@@ -0,0 +1,140 @@
+#include "std_extension/shared_mutex.hpp"
+#include "std_extension/parking_lot.hpp"
+#include "std_extension/unexpected_deferred_task.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace ext {
+namespace {
+std::size_t thread_index() noexcept {
+    static std::atomic_size_t next(0);
+
+    thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+template <class Validate>
+park_result park(const void *key, Validate validate,
+                 const std::chrono::steady_clock::time_point *abs_time) {
+    if (nullptr == abs_time) {
+        return parking_lot::park(key, 0, validate, [] {});
+    }
+    return parking_lot::park_until(key, 0, validate, [] {}, *abs_time);
+}
+} // namespace
+
+shared_mutex::shared_mutex()
+    : m_mask(std::bit_ceil(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                                                   MAX_SLOTS)) - 1)
+    , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+    , m_writer(false) {}
+
+shared_mutex::Slot &shared_mutex::slot() noexcept { return m_slots[thread_index() & m_mask]; }
+
+bool shared_mutex::hasReaders() const noexcept {
+    for (std::size_t i = 0; i <= m_mask; ++i) {
+        if (0 != m_slots[i].m_readers.load()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void shared_mutex::lock() { lockUntil(nullptr); }
+
+bool shared_mutex::try_lock() {
+    bool expected = false;
+    if (!m_writer.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+    if (hasReaders()) {
+        unlock();
+        return false;
+    }
+    return true;
+}
+
+bool shared_mutex::lockUntil(const std::chrono::steady_clock::time_point *abs_time) {
+    // MARK: claim the writer flag, directly handed over by the previous writer
+    for (bool expected = false; !m_writer.compare_exchange_weak(expected, true); expected = false) {
+        park_result res =
+            park(std::addressof(m_writer), [this] { return m_writer.load(); }, abs_time);
+        if (park_result::UNPARKED == res) {
+            break;
+        }
+
+        if (park_result::TIMEOUT == res) {
+            return false;
+        }
+    }
+
+    // MARK: new readers back off, wait for the current ones to leave
+    unexpected_deferred_task unexpected([this] { unlock(); });
+    while (hasReaders()) {
+        park_result res = park(m_slots.get(), [this] { return hasReaders(); }, abs_time);
+        if (park_result::TIMEOUT == res && hasReaders()) {
+            unlock();
+            return false;
+        }
+    }
+    return true;
+}
+
+void shared_mutex::unlock() {
+    bool handedOver = false;
+    parking_lot::unpark(
+        std::addressof(m_writer),
+        [&handedOver](std::uintptr_t) {
+            handedOver = true;
+            return unpark_control::REMOVE_BREAK;
+        },
+        [this, &handedOver](bool) {
+            if (!handedOver) {
+                m_writer.store(false);
+            }
+        });
+
+    if (!handedOver) {
+        parking_lot::unpark_all(this);
+    }
+}
+
+void shared_mutex::lock_shared() { lockSharedUntil(nullptr); }
+
+bool shared_mutex::try_lock_shared() {
+    Slot &own = slot();
+    own.m_readers.fetch_add(1);
+    if (!m_writer.load()) {
+        return true;
+    }
+
+    unlock_shared();
+    return false;
+}
+
+bool shared_mutex::lockSharedUntil(const std::chrono::steady_clock::time_point *abs_time) {
+    Slot &own = slot();
+    for (;;) {
+        own.m_readers.fetch_add(1);
+        if (!m_writer.load()) {
+            return true;
+        }
+
+        // a writer is pending, step aside until it is done
+        unlock_shared();
+        if (park_result::TIMEOUT == park(this, [this] { return m_writer.load(); }, abs_time)) {
+            return try_lock_shared();
+        }
+    }
+}
+
+void shared_mutex::unlock_shared() {
+    slot().m_readers.fetch_sub(1);
+    if (m_writer.load()) {
+        parking_lot::unpark_all(m_slots.get());
+    }
+}
+} // namespace ext
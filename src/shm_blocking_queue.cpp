@@ -0,0 +1,207 @@
+#include "std_extension/shm_blocking_queue.hpp"
+#include "std_extension/deferred_task.hpp"
+#include "std_extension/exception.hpp"
+#include "std_extension/unexpected_deferred_task.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ext {
+namespace detail {
+namespace {
+constexpr std::uint64_t MAGIC = 0x6578742d73686d31; // "ext-shm1"
+
+constexpr std::chrono::seconds INIT_TIMEOUT(1);
+
+template <class Pred> bool wait_initialized(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + INIT_TIMEOUT;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+} // namespace
+
+shm_ring::Header::Header(std::size_t capacity, std::size_t record_size)
+    : m_magic(0)
+    , m_capacity(capacity)
+    , m_recordSize(record_size)
+    , m_semPush(static_cast<unsigned int>(capacity), true)
+    , m_semPop(0, true)
+    , m_head(0)
+    , m_tail(0) {}
+
+shm_ring::shm_ring(const std::string &name, std::size_t capacity, std::size_t record_size)
+    : m_stride(strideOf(record_size))
+    , m_length(lengthOf(capacity, m_stride))
+    , m_header(nullptr) {
+    int  fd      = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    bool created = -1 != fd;
+    if (!created) {
+        if (EEXIST != errno) {
+            throw std::system_error(std::make_error_code(std::errc(errno)));
+        }
+
+        fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (-1 == fd) {
+            throw std::system_error(std::make_error_code(std::errc(errno)));
+        }
+    }
+
+    deferred_task closeFd([fd] { ::close(fd); });
+    unexpected_deferred_task unlinkShm([&name, created] {
+        if (created) {
+            ::shm_unlink(name.c_str());
+        }
+    });
+
+    if (created) {
+        if (::ftruncate(fd, static_cast<::off_t>(m_length)) != 0) {
+            throw std::system_error(std::make_error_code(std::errc(errno)));
+        }
+    } else {
+        bool sized = wait_initialized([fd] {
+            struct ::stat st;
+            return 0 == ::fstat(fd, &st) && 0 != st.st_size;
+        });
+        struct ::stat st;
+        if (!sized || ::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != m_length) {
+            throw exception("shm_blocking_queue layout mismatch");
+        }
+    }
+
+    void *addr = ::mmap(nullptr, m_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == addr) {
+        throw std::system_error(std::make_error_code(std::errc(errno)));
+    }
+
+    unexpected_deferred_task unmap([addr, this] { ::munmap(addr, m_length); });
+    if (created) {
+        m_header = ::new (addr) Header(capacity, record_size);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            ::new (std::addressof(slot(i))) Slot{i};
+        }
+        m_header->m_magic.store(MAGIC, std::memory_order_release);
+        return;
+    }
+
+    m_header = static_cast<Header *>(addr);
+    if (!wait_initialized([this] { return MAGIC == m_header->m_magic.load(); }) ||
+        m_header->m_capacity != capacity || m_header->m_recordSize != record_size) {
+        throw exception("shm_blocking_queue layout mismatch");
+    }
+}
+
+shm_ring::~shm_ring() { ::munmap(m_header, m_length); }
+
+void shm_ring::unlink(const std::string &name) {
+    if (::shm_unlink(name.c_str()) != 0 && ENOENT != errno) {
+        throw std::system_error(std::make_error_code(std::errc(errno)));
+    }
+}
+
+std::size_t shm_ring::strideOf(std::size_t record_size) {
+    std::size_t stride;
+    if (__builtin_add_overflow(sizeof(Slot) + alignof(Slot) - 1, record_size, &stride)) {
+        throw exception("shm_blocking_queue record size out of range");
+    }
+    return stride / alignof(Slot) * alignof(Slot);
+}
+
+std::size_t shm_ring::lengthOf(std::size_t capacity, std::size_t stride) {
+    if (0 == capacity || capacity > SEM_VALUE_MAX) {
+        throw exception("shm_blocking_queue capacity out of range");
+    }
+
+    std::size_t slots;
+    std::size_t length;
+    if (__builtin_mul_overflow(capacity, stride, &slots) ||
+        __builtin_add_overflow((sizeof(Header) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE, slots,
+                               &length) ||
+        length > static_cast<std::size_t>(std::numeric_limits<::off_t>::max())) {
+        throw exception("shm_blocking_queue size out of range");
+    }
+    return length;
+}
+
+shm_ring::Slot &shm_ring::slot(std::size_t pos) const noexcept {
+    auto *slots = reinterpret_cast<std::byte *>(m_header) +
+                  (sizeof(Header) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    return *reinterpret_cast<Slot *>(slots + pos % m_header->m_capacity * m_stride);
+}
+
+void shm_ring::push(const void *record) {
+    m_header->m_semPush.acquire();
+    commitPush(record);
+}
+
+bool shm_ring::try_push(const void *record) {
+    if (!m_header->m_semPush.try_acquire()) {
+        return false;
+    }
+    commitPush(record);
+    return true;
+}
+
+void shm_ring::pop(void *record) {
+    m_header->m_semPop.acquire();
+    commitPop(record);
+}
+
+bool shm_ring::try_pop(void *record) {
+    if (!m_header->m_semPop.try_acquire()) {
+        return false;
+    }
+    commitPop(record);
+    return true;
+}
+
+std::size_t shm_ring::size() const noexcept {
+    std::size_t head = m_header->m_head.load(std::memory_order_relaxed);
+    return m_header->m_tail.load(std::memory_order_relaxed) - head;
+}
+
+std::size_t shm_ring::capacity() const noexcept { return m_header->m_capacity; }
+
+void shm_ring::commitPush(const void *record) {
+    std::size_t pos  = m_header->m_tail.fetch_add(1, std::memory_order_relaxed);
+    Slot       &cell = slot(pos);
+
+    // the permit guarantees a free cell; its previous reader may still be copying out
+    while (cell.m_seq.load(std::memory_order_acquire) != pos) {
+        std::this_thread::yield();
+    }
+    std::memcpy(reinterpret_cast<std::byte *>(&cell) + sizeof(Slot), record,
+                m_header->m_recordSize);
+    cell.m_seq.store(pos + 1, std::memory_order_release);
+    m_header->m_semPop.release();
+}
+
+void shm_ring::commitPop(void *record) {
+    std::size_t pos  = m_header->m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot       &cell = slot(pos);
+
+    // the permit guarantees a published record; its writer may still be copying in
+    while (cell.m_seq.load(std::memory_order_acquire) != pos + 1) {
+        std::this_thread::yield();
+    }
+    std::memcpy(record, reinterpret_cast<const std::byte *>(&cell) + sizeof(Slot),
+                m_header->m_recordSize);
+    cell.m_seq.store(pos + m_header->m_capacity, std::memory_order_release);
+    m_header->m_semPush.release();
+}
+} // namespace detail
+} // namespace ext
@@ -1,31 +1,134 @@
 #include "std_extension/thread.hpp"
-#include "std_extension/condition_variable.hpp"
+#include "std_extension/deferred_task.hpp"
+#include "std_extension/interrupted_exception.hpp"
 
+#include <cerrno>
+#include <cstdint>
 #include <system_error>
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
 namespace ext {
+namespace detail {
+static ::timespec to_timespec(std::chrono::steady_clock::duration rel_time) noexcept {
+    auto     secs = std::chrono::duration_cast<std::chrono::seconds>(rel_time);
+    timespec ts{};
+    if (rel_time.count() > 0) {
+        ts.tv_sec  = secs.count();
+        ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(rel_time - secs).count();
+    }
+    return ts;
+}
+
+bool wait_fd(int fd, short events, const std::chrono::steady_clock::time_point *abs_time) {
+    thread::Spore *spore  = thread::get_spore();
+    ::pollfd       fds[2] = {{fd, events, 0}, {-1, POLLIN, 0}};
+    ::nfds_t       nfds   = 1;
+    if (nullptr != spore) {
+        int efd = spore->m_eventfd.load();
+        if (-1 == efd) {
+            efd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (-1 == efd) {
+                throw std::system_error(std::make_error_code(std::errc(errno)));
+            }
+            spore->m_eventfd.store(efd);
+        }
+        fds[1].fd = efd;
+        nfds      = 2;
+        thread::checkInterrupted(*spore);
+    }
+
+    for (;;) {
+        ::timespec  ts{};
+        ::timespec *timeout = nullptr;
+        if (nullptr != abs_time) {
+            ts      = to_timespec(*abs_time - std::chrono::steady_clock::now());
+            timeout = std::addressof(ts);
+        }
+
+        int n = ::ppoll(fds, nfds, timeout, nullptr);
+        if (0 > n) {
+            if (EINTR == errno) {
+                continue;
+            }
+            throw std::system_error(std::make_error_code(std::errc(errno)));
+        }
+
+        if (2 == nfds && 0 != fds[1].revents) {
+            std::uint64_t count = 0;
+            while (0 < ::read(fds[1].fd, &count, sizeof(count))) {}
+            thread::checkInterrupted(*spore);
+        }
+
+        if (0 != fds[0].revents) {
+            return true;
+        }
+
+        if (0 == n && nullptr != abs_time && std::chrono::steady_clock::now() >= *abs_time) {
+            return false;
+        }
+    }
+}
+
+void precise_sleep_until(const std::chrono::steady_clock::time_point &abs_time,
+                         std::chrono::nanoseconds                     spin_for) {
+    thread::Spore *spore = thread::get_spore();
+    if (nullptr != spore) {
+        thread::checkInterrupted(*spore);
+    }
+
+    // MARK: sleep on the parker with minimal timer slack, leaving the tail to spin
+    int slack = ::prctl(PR_GET_TIMERSLACK);
+    if (0 < slack) {
+        ::prctl(PR_SET_TIMERSLACK, 1UL);
+    }
+    deferred_task restore([slack] {
+        if (0 < slack) {
+            ::prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(slack));
+        }
+    });
+
+    detail::parker &parker = thread::get_parker();
+    auto            coarse = abs_time - spin_for;
+    while (std::chrono::steady_clock::now() < coarse) {
+        parker.park_until(coarse);
+        if (nullptr != spore) {
+            thread::checkInterrupted(*spore);
+        }
+    }
+
+    while (std::chrono::steady_clock::now() < abs_time) {
+        if (nullptr != spore && spore->m_interrupted.load(std::memory_order_relaxed)) {
+            thread::checkInterrupted(*spore);
+        }
+    }
+}
+} // namespace detail
+
 namespace this_thread {
 void yield() noexcept { std::this_thread::yield(); }
 
 std::thread::id get_id() noexcept { return std::this_thread::get_id(); }
-} // namespace this_thread
 
-std::unordered_map<std::thread::id, std::shared_ptr<thread::Spore>> &
-thread::get_threads() noexcept {
-    static std::unordered_map<std::thread::id, std::shared_ptr<Spore>> threads;
-    return threads;
-}
+bool wait_readable(int fd) { return detail::wait_fd(fd, POLLIN, nullptr); }
 
-std::shared_mutex &thread::get_mutex() noexcept {
-    static std::shared_mutex mutex;
-    return mutex;
-}
+bool wait_writable(int fd) { return detail::wait_fd(fd, POLLOUT, nullptr); }
+} // namespace this_thread
 
-std::shared_ptr<thread::Spore> thread::get_spore() {
-    auto            &threads = get_threads();
-    std::shared_lock lock(get_mutex());
-    auto             it = threads.find(std::this_thread::get_id());
-    return threads.end() == it ? nullptr : it->second;
+thread::Spore::Spore() noexcept
+    : m_interrupted(false)
+    , m_eventfd(-1) {}
+
+thread::Spore::~Spore() {
+    if (m_thread.joinable()) {
+        m_thread.detach();
+    }
+    if (-1 != m_eventfd) {
+        ::close(m_eventfd);
+    }
 }
 
 thread::thread() noexcept
@@ -43,11 +146,7 @@ void thread::join() {
     if (nullptr == spore) {
         throw std::system_error(std::make_error_code(std::errc::invalid_argument));
     }
-    std::thread::id tid = spore->m_thread.get_id();
     spore->m_thread.join();
-    auto           &threads = get_threads();
-    std::lock_guard guard(get_mutex());
-    threads.erase(tid);
 }
 
 void thread::detach() {
@@ -55,9 +154,6 @@ void thread::detach() {
     if (nullptr == spore) {
         throw std::system_error(std::make_error_code(std::errc::invalid_argument));
     }
-    auto           &threads = get_threads();
-    std::lock_guard guard(spore->m_mutex);
-    threads.erase(spore->m_thread.get_id());
     spore->m_thread.detach();
 }
 
@@ -85,12 +181,18 @@ void thread::interrupt() {
     }
 
     spore->m_interrupted = true;
-    std::lock_guard guard(spore->m_mutex);
-    while (nullptr != spore->m_cv_cv && spore->m_interrupted) {
-        spore->m_cv_cv->notify_all();
-        spore->m_mutex.unlock();
-        std::this_thread::yield();
-        spore->m_mutex.lock();
+    spore->m_parker.unpark();
+
+    int efd = spore->m_eventfd.load();
+    if (-1 != efd) {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto res = ::write(efd, &one, sizeof(one));
+    }
+}
+
+void thread::checkInterrupted(Spore &spore) {
+    if (spore.m_interrupted.exchange(false)) {
+        throw interrupted_exception();
     }
 }
 } // namespace ext
@@ -0,0 +1,240 @@
+#include "std_extension/memory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace ext {
+namespace detail {
+struct tracking_type {
+    tracking_type(std::string_view name, std::size_t index) noexcept
+        : m_name(name)
+        , m_index(index) {}
+
+    void record(std::uint64_t allocations, std::uint64_t deallocations,
+                std::uint64_t allocatedBytes, std::uint64_t freedBytes) noexcept {
+        m_allocations.fetch_add(allocations, std::memory_order_relaxed);
+        m_deallocations.fetch_add(deallocations, std::memory_order_relaxed);
+        m_allocatedBytes.fetch_add(allocatedBytes, std::memory_order_relaxed);
+        m_freedBytes.fetch_add(freedBytes, std::memory_order_relaxed);
+    }
+
+    void flush(std::int64_t delta) noexcept {
+        std::int64_t live = m_live.fetch_add(delta, std::memory_order_relaxed) + delta;
+        raisePeak(live);
+    }
+
+    void raisePeak(std::int64_t live) noexcept {
+        std::int64_t peak = m_peak.load(std::memory_order_relaxed);
+        while (live > peak &&
+               !m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    const std::string_view m_name;
+    const std::size_t      m_index;
+
+    // totals of exited threads, and of threads that could not get a slot
+    std::atomic_uint64_t m_allocations    = 0;
+    std::atomic_uint64_t m_deallocations  = 0;
+    std::atomic_uint64_t m_allocatedBytes = 0;
+    std::atomic_uint64_t m_freedBytes     = 0;
+
+    // live bytes as flushed by threads, drives the peak
+    std::atomic_int64_t m_live = 0;
+    std::atomic_int64_t m_peak = 0;
+};
+
+namespace {
+constexpr std::size_t  CHUNK_SIZE  = 64;
+constexpr std::size_t  MAX_CHUNKS  = 64;
+constexpr std::int64_t FLUSH_BYTES = 64 * 1024;
+
+// written by the owning thread only, read by snapshots
+struct Slot {
+    static void bump(std::atomic_uint64_t &counter, std::uint64_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::atomic_uint64_t m_allocations    = 0;
+    std::atomic_uint64_t m_deallocations  = 0;
+    std::atomic_uint64_t m_allocatedBytes = 0;
+    std::atomic_uint64_t m_freedBytes     = 0;
+    std::int64_t         m_flushed        = 0;
+};
+
+struct ThreadCounters;
+
+struct Registry {
+    std::mutex                                            m_mutex;
+    std::unordered_map<std::string_view, tracking_type *> m_byName;
+    std::vector<tracking_type *>                          m_types;
+    ThreadCounters                                       *m_threads = nullptr;
+};
+
+// leaked on purpose: threads may still allocate while statics are destroyed
+Registry &registry() noexcept {
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+// MARK: per-thread counters, merged into the type on snapshot and on thread exit
+struct ThreadCounters {
+    ThreadCounters() noexcept {
+        std::lock_guard guard(registry().m_mutex);
+        m_next = registry().m_threads;
+        if (nullptr != m_next) {
+            m_next->m_prev = this;
+        }
+        registry().m_threads = this;
+    }
+
+    ~ThreadCounters() {
+        {
+            std::lock_guard guard(registry().m_mutex);
+            for (tracking_type *type : registry().m_types) {
+                Slot *slot = find(type->m_index);
+                if (nullptr == slot) {
+                    continue;
+                }
+                std::uint64_t allocatedBytes = slot->m_allocatedBytes.load();
+                std::uint64_t freedBytes     = slot->m_freedBytes.load();
+                type->record(slot->m_allocations.load(), slot->m_deallocations.load(),
+                             allocatedBytes, freedBytes);
+                type->flush(static_cast<std::int64_t>(allocatedBytes - freedBytes) -
+                            slot->m_flushed);
+            }
+
+            (nullptr != m_prev ? m_prev->m_next : registry().m_threads) = m_next;
+            if (nullptr != m_next) {
+                m_next->m_prev = m_prev;
+            }
+        }
+
+        for (std::atomic<Slot *> &chunk : m_chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+        destroyed() = true;
+    }
+
+    static bool &destroyed() noexcept {
+        thread_local constinit bool destroyed = false;
+        return destroyed;
+    }
+
+    Slot *find(std::size_t index) const noexcept {
+        if (index >= CHUNK_SIZE * MAX_CHUNKS) {
+            return nullptr;
+        }
+        Slot *chunk = m_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+        return nullptr != chunk ? chunk + index % CHUNK_SIZE : nullptr;
+    }
+
+    Slot *slot(std::size_t index) noexcept {
+        if (index >= CHUNK_SIZE * MAX_CHUNKS) {
+            return nullptr;
+        }
+
+        std::atomic<Slot *> &chunk = m_chunks[index / CHUNK_SIZE];
+        if (nullptr == chunk.load(std::memory_order_relaxed)) {
+            chunk.store(new (std::nothrow) Slot[CHUNK_SIZE], std::memory_order_release);
+        }
+        Slot *slots = chunk.load(std::memory_order_relaxed);
+        return nullptr != slots ? slots + index % CHUNK_SIZE : nullptr;
+    }
+
+    std::array<std::atomic<Slot *>, MAX_CHUNKS> m_chunks = {};
+    ThreadCounters                             *m_prev   = nullptr;
+    ThreadCounters                             *m_next   = nullptr;
+};
+
+Slot *thread_slot(const tracking_type &type) noexcept {
+    if (ThreadCounters::destroyed()) {
+        return nullptr;
+    }
+    thread_local ThreadCounters counters;
+    return counters.slot(type.m_index);
+}
+} // namespace
+
+tracking_type &tracking_register(std::string_view name) {
+    Registry       &types = registry();
+    std::lock_guard guard(types.m_mutex);
+    auto [it, inserted] = types.m_byName.try_emplace(name, nullptr);
+    if (inserted) {
+        it->second = new tracking_type(name, types.m_types.size());
+        types.m_types.push_back(it->second);
+    }
+    return *it->second;
+}
+
+void tracking_allocated(tracking_type &type, std::size_t bytes) noexcept {
+    Slot *slot = thread_slot(type);
+    if (nullptr == slot) {
+        type.record(1, 0, bytes, 0);
+        type.flush(static_cast<std::int64_t>(bytes));
+        return;
+    }
+
+    Slot::bump(slot->m_allocations, 1);
+    Slot::bump(slot->m_allocatedBytes, bytes);
+    std::int64_t delta = static_cast<std::int64_t>(slot->m_allocatedBytes.load() -
+                                                   slot->m_freedBytes.load()) -
+                         slot->m_flushed;
+    if (delta >= FLUSH_BYTES) {
+        type.flush(delta);
+        slot->m_flushed += delta;
+    }
+}
+
+void tracking_deallocated(tracking_type &type, std::size_t bytes) noexcept {
+    Slot *slot = thread_slot(type);
+    if (nullptr == slot) {
+        type.record(0, 1, 0, bytes);
+        type.flush(-static_cast<std::int64_t>(bytes));
+        return;
+    }
+
+    Slot::bump(slot->m_deallocations, 1);
+    Slot::bump(slot->m_freedBytes, bytes);
+    std::int64_t delta = static_cast<std::int64_t>(slot->m_allocatedBytes.load() -
+                                                   slot->m_freedBytes.load()) -
+                         slot->m_flushed;
+    if (delta <= -FLUSH_BYTES) {
+        type.flush(delta);
+        slot->m_flushed += delta;
+    }
+}
+} // namespace detail
+
+std::vector<allocation_stats> allocation_snapshot() {
+    detail::Registry             &types = detail::registry();
+    std::lock_guard               guard(types.m_mutex);
+    std::vector<allocation_stats> snapshot;
+    snapshot.reserve(types.m_types.size());
+    for (detail::tracking_type *type : types.m_types) {
+        std::uint64_t allocations    = type->m_allocations.load(std::memory_order_relaxed);
+        std::uint64_t deallocations  = type->m_deallocations.load(std::memory_order_relaxed);
+        std::uint64_t allocatedBytes = type->m_allocatedBytes.load(std::memory_order_relaxed);
+        std::uint64_t freedBytes     = type->m_freedBytes.load(std::memory_order_relaxed);
+        for (auto *counters = types.m_threads; nullptr != counters; counters = counters->m_next) {
+            detail::Slot *slot = counters->find(type->m_index);
+            if (nullptr != slot) {
+                allocations += slot->m_allocations.load(std::memory_order_relaxed);
+                deallocations += slot->m_deallocations.load(std::memory_order_relaxed);
+                allocatedBytes += slot->m_allocatedBytes.load(std::memory_order_relaxed);
+                freedBytes += slot->m_freedBytes.load(std::memory_order_relaxed);
+            }
+        }
+
+        auto live = static_cast<std::int64_t>(allocatedBytes - freedBytes);
+        type->raisePeak(live);
+        snapshot.push_back({type->m_name, allocations, deallocations, live,
+                            type->m_peak.load(std::memory_order_relaxed)});
+    }
+    return snapshot;
+}
+} // namespace ext